@@ -23,6 +23,10 @@ ZEROPAGE_EXTERN(unsigned char, lastControllerState);
 // Bit of a special case - this is exported from assembly in crt0.asm - it's the number of frames since the system started.
 // Note: DO NOT try to alter this with your code; you will almost certainly cause unusual behavior.
 ZEROPAGE_EXTERN(unsigned int, frameCount);
+// Also from crt0.asm: the copy of OAM that oam_spr writes to, and that gets sent to the PPU every frame. Each sprite is
+// 4 bytes: y, tile, attributes, x. Using oam_spr is safer; this is here for code that needs to move a lot of sprite
+// data around quickly.
+extern unsigned char oamBuffer[256];
 ZEROPAGE_EXTERN(unsigned char, everyOtherCycle);
 
 // A few temp variables we'll reuse a lot... be sure not to expect the state of these to stick around
@@ -1,6 +1,4 @@
 // Some defines for the elements in the HUD
-#define PRG_BANK_HUD 2
-
 #define HUD_POSITION_START 0x0300
 #define HUD_HEART_START 0x0361
 #define HUD_KEY_START 0x037d
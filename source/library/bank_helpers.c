@@ -19,13 +19,17 @@ void bank_push(unsigned char bankId) {
     if (bankLevel > MAX_BANK_DEPTH) {
         crash_error(ERR_RECURSION_DEPTH, ERR_RECURSION_DEPTH_EXPLANATION, "MAX_BANK_DEPTH", MAX_BANK_DEPTH);
     }
-    set_prg_bank(bankId);
+    // Writing to the mapper takes a while, so skip it if we're already there. The bank packer tries to put code that
+    // calls each other into the same bank, so this happens a lot.
+    if (get_prg_bank() != bankId) {
+        set_prg_bank(bankId);
+    }
 }
 
 // Go back to the last bank pushed on using bank_push.
 void bank_pop() {
     --bankLevel;
-    if (bankLevel > 0) {
+    if (bankLevel > 0 && get_prg_bank() != bankBuffer[bankLevel-1]) {
         set_prg_bank(bankBuffer[bankLevel-1]);
     }
 }
@@ -1,5 +1,8 @@
 // Contains functions to help with working with multle PRG/CHR banks
 
+// Generated at build time - defines a PRG_BANK_ constant for every CODE_BANK() in the game.
+#include "temp/prg_banks.h"
+
 // Maximum level of recursion to allow with banked_call and similar functions. 
 // Note that each one of these is a byte of ram from zeropage!
 #define MAX_BANK_DEPTH 10
@@ -10,6 +13,7 @@
 void banked_call(unsigned char bankId, void (*method)(void));
 
 // Switch to the given bank, and keep track of the current bank, so that we may jump back to it as needed.
+// If we are already in that bank, the (slow) bank switch is skipped.
 void bank_push(unsigned char bankId);
 
 // Go back to the last bank pushed on using bank_push.
@@ -54,6 +58,9 @@ void __fastcall__ set_mirroring(unsigned char mirroring);
 // NOTE: If you call this in a .c file and expose it in `globals.h`, be sure to mark it with `ZEROPAGE_EXTERN` there.
 #define STR_HELPER(x) #x
 #define STR(x) STR_HELPER(x)
+// NOTE: The host simulation build (tools/host_sim) has its own versions of these in host_sim.h, since a regular C
+// compiler doesn't know about cc65's segments.
+#ifndef HOST_SIM
 #define ZEROPAGE_DEF(defa, defb) \
     _Pragma("bssseg (push,\"ZEROPAGE\")") \
     _Pragma("dataseg (push, \"ZEROPAGE\")") \
@@ -69,6 +76,15 @@ void __fastcall__ set_mirroring(unsigned char mirroring);
     _Pragma("dataseg (pop)")
 
 
+// Put an array into the 8k of extra ram on the cartridge, (WRAM, at $6000) instead of the regular ram. This ram is
+// battery-backed, so it is kept when the console is turned off, and emulators save it to a `.sav` file.
+// NOTE: Unlike regular variables, these are NOT cleared when the game starts. 
+// (Usage: WRAM_ARRAY_DEF(type, variableName, size) ; eg WRAM_ARRAY_DEF(unsigned char, myArray, 0x100))
+#define WRAM_ARRAY_DEF(defa, defb, defArr) \
+    _Pragma("bssseg (push,\"WRAM\")") \
+    defa defb[defArr]; \
+    _Pragma("bssseg (pop)")
+
 // Mark a variable referenced in a header file as being a zeropage symbol.
 // Any time you set a variable as a ZEROPAGE_DEF, you will want to also update any header files referencing it
 // with this function.
@@ -76,8 +92,13 @@ void __fastcall__ set_mirroring(unsigned char mirroring);
 #define ZEROPAGE_EXTERN(defa, defb) extern defa defb; _Pragma("zpsym (\"" STR(defb) "\")")
 #define ZEROPAGE_ARRAY_EXTERN(defa, defb, defArr) extern defa defb[defArr]; _Pragma("zpsym (\"" STR(defb) "\")")
 
-// Set the PRG bank to put the code in the current file into.
-#define CODE_BANK(id) _Pragma("rodataseg (push, \"ROM_0" STR(id) "\")") _Pragma("codeseg (push, \"ROM_0" STR(id) "\")")
+// Put the code in the current file into a banked unit with the given name. (eg: CODE_BANK(PRG_BANK_TITLE))
+// You don't pick the bank number yourself; tools/bank_packer finds room for every unit when you build, and defines
+// a PRG_BANK_ constant with the same name that you can pass to banked_call.
+// NOTE: This uses #id directly, rather than STR(id), so that the name isn't replaced by the bank number.
+#define CODE_BANK(id) _Pragma("rodataseg (push, \"" #id "\")") _Pragma("codeseg (push, \"" #id "\")")
 
 // Reverse the actions of the CODE_BANK function, if you need to go back to the default bank.
-#define CODE_BANK_POP() _Pragma("rodataseg (pop)") _Pragma("codeseg (pop)")
\ No newline at end of file
+#define CODE_BANK_POP() _Pragma("rodataseg (pop)") _Pragma("codeseg (pop)")
+
+#endif
\ No newline at end of file
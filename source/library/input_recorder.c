@@ -0,0 +1,115 @@
+// Records and replays controller input. See input_recorder.h for details on how to use this.
+// Note: This has to stay in the kernel, since it is called from code in every other bank.
+#include "source/neslib_asm/neslib.h"
+#include "source/library/bank_helpers.h"
+#include "source/library/input_recorder.h"
+#include "source/menus/error.h"
+
+#if defined(INPUT_RECORD) || defined(INPUT_REPLAY)
+
+WRAM_ARRAY_DEF(unsigned char, inputRecording, INPUT_RECORDING_SIZE);
+
+// Where in inputRecording the run of button presses we're working on starts.
+unsigned int inputRecordingPosition;
+// Replay only: how many runs are left after this one, and how many reads are left in this one.
+unsigned int inputReplayRunsLeft;
+unsigned char inputReplayReadsLeft;
+unsigned char inputReplayFinished;
+// The buttons we're about to return.
+unsigned char inputRecorderButtons;
+
+// Little helper to read/write the 2-byte numbers in the header.
+#define INPUT_RECORDING_HEADER_INT(pos) (*(unsigned int*)(&inputRecording[pos]))
+
+void input_recorder_init() {
+    unsigned char hasRecording = inputRecording[INPUT_RECORDING_POS_MAGIC] == INPUT_RECORDING_MAGIC_0 && 
+        inputRecording[INPUT_RECORDING_POS_MAGIC + 1] == INPUT_RECORDING_MAGIC_1 && 
+        inputRecording[INPUT_RECORDING_POS_VERSION] == INPUT_RECORDING_VERSION;
+
+    #ifdef INPUT_RECORD
+        // Never overwrite a finished recording - the game may have just reset at the end of one.
+        if (hasRecording && inputRecording[INPUT_RECORDING_POS_STATUS] == INPUT_RECORDING_STATUS_FINISHED) {
+            return;
+        }
+        inputRecording[INPUT_RECORDING_POS_MAGIC] = INPUT_RECORDING_MAGIC_0;
+        inputRecording[INPUT_RECORDING_POS_MAGIC + 1] = INPUT_RECORDING_MAGIC_1;
+        inputRecording[INPUT_RECORDING_POS_VERSION] = INPUT_RECORDING_VERSION;
+        inputRecording[INPUT_RECORDING_POS_STATUS] = INPUT_RECORDING_STATUS_RECORDING;
+        INPUT_RECORDING_HEADER_INT(INPUT_RECORDING_POS_SEED) = 0;
+        INPUT_RECORDING_HEADER_INT(INPUT_RECORDING_POS_RUN_COUNT) = 0;
+        // Start one run before the data, so the first read always starts a new run.
+        inputRecordingPosition = INPUT_RECORDING_HEADER_SIZE - 2;
+    #else
+        if (!hasRecording) {
+            crash_error(ERR_NO_INPUT_RECORDING, ERR_NO_INPUT_RECORDING_EXPLANATION, NULL, 0);
+        }
+        inputRecordingPosition = INPUT_RECORDING_HEADER_SIZE;
+        inputReplayRunsLeft = INPUT_RECORDING_HEADER_INT(INPUT_RECORDING_POS_RUN_COUNT);
+        inputReplayReadsLeft = inputRecording[INPUT_RECORDING_HEADER_SIZE];
+        inputReplayFinished = (inputReplayRunsLeft == 0);
+    #endif
+}
+
+unsigned char __fastcall__ input_pad_poll(unsigned char pad) {
+    // We only record the first controller; anything else reads the real thing.
+    if (pad != 0) {
+        return pad_poll(pad);
+    }
+
+    #ifdef INPUT_RECORD
+        inputRecorderButtons = pad_poll(0);
+        if (inputRecording[INPUT_RECORDING_POS_STATUS] != INPUT_RECORDING_STATUS_RECORDING) {
+            return inputRecorderButtons;
+        }
+
+        if (inputRecordingPosition >= INPUT_RECORDING_HEADER_SIZE && inputRecording[inputRecordingPosition + 1] == inputRecorderButtons && inputRecording[inputRecordingPosition] != 255) {
+            // Same buttons as last time; make the current run one longer.
+            ++inputRecording[inputRecordingPosition];
+        } else if (inputRecordingPosition + 4 <= INPUT_RECORDING_SIZE) {
+            // Buttons changed (or the run is full) so start a new run.
+            inputRecordingPosition += 2;
+            inputRecording[inputRecordingPosition] = 1;
+            inputRecording[inputRecordingPosition + 1] = inputRecorderButtons;
+            ++INPUT_RECORDING_HEADER_INT(INPUT_RECORDING_POS_RUN_COUNT);
+        } else {
+            // Out of space; stop here, and keep what we have.
+            inputRecording[INPUT_RECORDING_POS_STATUS] = INPUT_RECORDING_STATUS_FINISHED;
+        }
+        return inputRecorderButtons;
+    #else
+        if (inputReplayFinished) {
+            return 0;
+        }
+        inputRecorderButtons = inputRecording[inputRecordingPosition + 1];
+        --inputReplayReadsLeft;
+        if (inputReplayReadsLeft == 0) {
+            --inputReplayRunsLeft;
+            if (inputReplayRunsLeft == 0) {
+                inputReplayFinished = 1;
+            } else {
+                inputRecordingPosition += 2;
+                inputReplayReadsLeft = inputRecording[inputRecordingPosition];
+            }
+        }
+        return inputRecorderButtons;
+    #endif
+}
+
+unsigned int __fastcall__ input_random_seed(unsigned int seed) {
+    #ifdef INPUT_RECORD
+        if (inputRecording[INPUT_RECORDING_POS_STATUS] == INPUT_RECORDING_STATUS_RECORDING) {
+            INPUT_RECORDING_HEADER_INT(INPUT_RECORDING_POS_SEED) = seed;
+        }
+        return seed;
+    #else
+        return INPUT_RECORDING_HEADER_INT(INPUT_RECORDING_POS_SEED);
+    #endif
+}
+
+void input_recorder_stop() {
+    #ifdef INPUT_RECORD
+        inputRecording[INPUT_RECORDING_POS_STATUS] = INPUT_RECORDING_STATUS_FINISHED;
+    #endif
+}
+
+#endif
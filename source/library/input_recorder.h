@@ -0,0 +1,61 @@
+// Lets you record everything pressed on the first controller, and play it back later exactly the same way. This is
+// mainly useful for testing performance changes: if the game gets the same input and the same random seed, it plays
+// out identically every time.
+//
+// Turn this on by setting INPUT_MODE in the makefile:
+// - record: Every controller read is saved into WRAM, which emulators save to a `.sav` file next to the rom.
+// - replay: Controller reads come from the recording in WRAM instead of the controller. Put a `.sav` file from a
+//           recording next to the rom (or have your emulator/test harness load it into WRAM) before starting.
+// When INPUT_MODE is empty, (the default) none of this code is included, and input_pad_poll is just pad_poll.
+//
+// The recording is one entry per controller read, rather than per frame, so a replay stays in sync even if the
+// game runs slower or faster than when it was recorded. Because of that, always read the controller with
+// input_pad_poll, and only once per frame.
+
+// How much of WRAM to use for the recording. Each change in buttons takes 2 bytes, (and so does holding the
+// same buttons for more than 255 frames) so 4k is usually good for several minutes of play.
+#define INPUT_RECORDING_SIZE 0x1000
+
+// Layout of the recording: a small header, followed by pairs of (number of reads, buttons held).
+#define INPUT_RECORDING_MAGIC_0 'I'
+#define INPUT_RECORDING_MAGIC_1 'R'
+#define INPUT_RECORDING_VERSION 1
+
+#define INPUT_RECORDING_POS_MAGIC 0
+#define INPUT_RECORDING_POS_VERSION 2
+#define INPUT_RECORDING_POS_STATUS 3
+#define INPUT_RECORDING_POS_SEED 4
+#define INPUT_RECORDING_POS_RUN_COUNT 6
+#define INPUT_RECORDING_HEADER_SIZE 8
+
+#define INPUT_RECORDING_STATUS_RECORDING 0
+// Set when the game resets or the recording fills up. A finished recording is never overwritten; delete the .sav
+// file to record a new one.
+#define INPUT_RECORDING_STATUS_FINISHED 1
+
+#if defined(INPUT_RECORD) || defined(INPUT_REPLAY)
+
+// Set to 1 once a replay runs out of input. From then on, input_pad_poll acts like nothing is pressed.
+extern unsigned char inputReplayFinished;
+
+// Get ready to record or replay. Call this once when the game starts.
+void input_recorder_init(void);
+
+// Read the controller (or the recording, in replay mode) and return the buttons held, like pad_poll.
+unsigned char __fastcall__ input_pad_poll(unsigned char pad);
+
+// Pass the random seed you were going to use through this. In record mode it is saved into the recording; in
+// replay mode the seed from the recording is returned instead.
+unsigned int __fastcall__ input_random_seed(unsigned int seed);
+
+// Mark the recording as finished. Call this before resetting the console.
+void input_recorder_stop(void);
+
+#else
+
+#define input_recorder_init()
+#define input_pad_poll(pad) pad_poll(pad)
+#define input_random_seed(seed) (seed)
+#define input_recorder_stop()
+
+#endif
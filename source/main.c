@@ -20,22 +20,31 @@ This has the main loop for the game, which is then used to call out to other cod
 #include "source/sprites/sprite_definitions.h"
 #include "source/menus/input_helpers.h"
 #include "source/menus/game_over.h"
+#include "source/library/input_recorder.h"
 
 
 // Method to set a bunch of variables to default values when the system starts up.
 // Note that if variables aren't set in this method, they will start at 0 on NES startup.
 void initialize_variables() {
 
-    playerOverworldPosition = 0; // Which tile on the overworld to start with; 0-62
+    playerOverworldPosition = 0; // Which room on the overworld to start with; 0 to OVERWORLD_ROOM_COUNT-1
     playerHealth = 5; // Player's starting health - how many hearts to show on the HUD.
     playerMaxHealth = 5; // Player's max health - how many hearts to let the player collect before it doesn't count.
     playerXPosition = (128 << PLAYER_POSITION_SHIFT); // X position on the screen to start (increasing numbers as you go left to right. Just change the number)
     playerYPosition = (128 << PLAYER_POSITION_SHIFT); // Y position on the screen to start (increasing numbers as you go top to bottom. Just change the number)
     playerDirection = SPRITE_DIRECTION_DOWN; // What direction to have the player face to start.
 
-    lastPlayerSpriteCollisionId = NO_SPRITE_HIT;
+    playerSpriteCollisionCount = 0;
 
     currentWorldId = WORLD_OVERWORLD; // The ID of the world to load.
+    clear_room_cache(); // Forget any rooms left in WRAM from the last time the game was played.
+
+    // Find the animation sequences for sprites, before we load any.
+    banked_call(PRG_BANK_MAP_SPRITES, init_sprite_animations);
+    START_SPRITE_ANIMATION(playerAnimationFrame, playerAnimationTime, spriteAnimationSequenceStart[PLAYER_WALK_ANIMATION]);
+
+    // Only does anything if INPUT_MODE is set in the makefile - see input_recorder.h
+    input_recorder_init();
     
     // Little bit of generic initialization below this point - we need to set
     // The system up to use a different hardware bank for sprites vs backgrounds.
@@ -78,7 +87,8 @@ void main() {
                 ppu_on_all();
 
                 // Seed the random number generator here, using the time since console power on as a seed
-                set_rand(frameCount);
+                // (When replaying recorded input, we use the seed from the recording instead, so the game plays out the same.)
+                set_rand(input_random_seed(frameCount));
                 
                 // Map drawing is complete; let the player play the game!
                 music_play(SONG_OVERWORLD);
@@ -126,6 +136,7 @@ void main() {
                 fade_in();
                 banked_call(PRG_BANK_MENU_INPUT_HELPERS, wait_for_start);
                 fade_out();
+                input_recorder_stop();
                 reset();
                 break;
             case GAME_STATE_CREDITS:
@@ -144,6 +155,7 @@ void main() {
                 fade_in();
                 banked_call(PRG_BANK_MENU_INPUT_HELPERS, wait_for_start);
                 fade_out();
+                input_recorder_stop();
                 reset();
                 break;
             default: 
@@ -2,16 +2,137 @@
 #include "source/neslib_asm/neslib.h"
 #include "source/library/bank_helpers.h"
 #include "source/map/map.h"
+#include "source/map/load_map.h"
+#include "source/sprites/collision.h"
 #include "source/globals.h"
 
+unsigned char currentMapCollision[MAP_COLLISION_BYTES];
+
+unsigned char currentRoomPart;
+unsigned char currentRoomBank;
+const unsigned char* currentRoomData;
+
+// How to find a room in each world, by world id. tmx2c writes a _find_room function for every map.
+void (* const worldFindRoom[WORLD_COUNT])(void) = {
+    overworld_find_room
+};
+
+// Where each world's bits start in spritePersistence, by world id. (See SPRITE_PERSIST_BITS in map.h)
+const unsigned int worldSpritePersistFirstBit[WORLD_COUNT] = {
+    WORLD_OVERWORLD_SPRITE_PERSIST_FIRST_BIT
+};
+
+// The room cache, in the extra ram on the cartridge. (See ROOM_CACHE_SIZE in load_map.h) Each slot has a copy of a
+// room's data and collision, just like load_map left them in currentMap and currentMapCollision, and which world and
+// room it is.
+WRAM_ARRAY_DEF(unsigned char, roomCacheMap, ROOM_CACHE_SIZE * ROOM_CACHE_MAP_BYTES);
+WRAM_ARRAY_DEF(unsigned char, roomCacheCollision, ROOM_CACHE_SIZE * MAP_COLLISION_BYTES);
+WRAM_ARRAY_DEF(unsigned int, roomCacheSpritePersistStart, ROOM_CACHE_SIZE);
+WRAM_ARRAY_DEF(unsigned char, roomCacheWorld, ROOM_CACHE_SIZE);
+WRAM_ARRAY_DEF(unsigned char, roomCacheRoom, ROOM_CACHE_SIZE);
+// The slots, from the one used most recently to the one used longest ago.
+WRAM_ARRAY_DEF(unsigned char, roomCacheOrder, ROOM_CACHE_SIZE);
+// The slot load_map is using, whether the room was already in it, and where its data is.
+unsigned char roomCacheSlot;
+unsigned char roomCacheHit;
+unsigned char* roomCacheSlotMap;
+unsigned char* roomCacheSlotCollision;
+
+// This lives in the fixed bank with load_map, so the player and sprite code can use it from any bank.
+const unsigned char collisionBitMask[8] = {
+    0x80,
+    0x40,
+    0x20,
+    0x10,
+    0x08,
+    0x04,
+    0x02,
+    0x01
+};
+
+// The lookup tables for MAP_POSITION_FROM_PIXELS. These are built by the compiler from the macros below, so if you
+// change HUD_PIXEL_HEIGHT, the tables change with it. (Like collisionBitMask, they live in the fixed bank.)
+#define MAP_COLUMN_FOR_PIXEL(xPixel) ((xPixel) >> 4)
+#define MAP_ROW_FOR_PIXEL(yPixel) ((unsigned char)((yPixel) - HUD_PIXEL_HEIGHT) & 0xf0)
+
+// Helpers to repeat a macro for every pixel from 0 to 255.
+#define MAP_LOOKUP_4(fn, pixel) fn(pixel), fn((pixel) + 1), fn((pixel) + 2), fn((pixel) + 3)
+#define MAP_LOOKUP_16(fn, pixel) MAP_LOOKUP_4(fn, pixel), MAP_LOOKUP_4(fn, (pixel) + 4), MAP_LOOKUP_4(fn, (pixel) + 8), MAP_LOOKUP_4(fn, (pixel) + 12)
+#define MAP_LOOKUP_64(fn, pixel) MAP_LOOKUP_16(fn, pixel), MAP_LOOKUP_16(fn, (pixel) + 16), MAP_LOOKUP_16(fn, (pixel) + 32), MAP_LOOKUP_16(fn, (pixel) + 48)
+#define MAP_LOOKUP_256(fn) MAP_LOOKUP_64(fn, 0), MAP_LOOKUP_64(fn, 64), MAP_LOOKUP_64(fn, 128), MAP_LOOKUP_64(fn, 192)
+
+const unsigned char mapTileColumnLookup[256] = { MAP_LOOKUP_256(MAP_COLUMN_FOR_PIXEL) };
+const unsigned char mapTileRowLookup[256] = { MAP_LOOKUP_256(MAP_ROW_FOR_PIXEL) };
+
+void clear_room_cache() {
+    for (i = 0; i != ROOM_CACHE_SIZE; ++i) {
+        roomCacheWorld[i] = ROOM_CACHE_EMPTY;
+        roomCacheOrder[i] = i;
+    }
+}
+
 // Loads the map at the player's current position into the ram variable given. 
 // Kept in a separate file, as this must remain in the primary bank so it can
 // read data from another prg bank.
 void load_map() {
+
+    // Look through the room cache for this room, most recently used first. If it isn't there, this leaves us with the
+    // slot that was used longest ago, which is the one we'll replace.
+    for (i = 0; i != ROOM_CACHE_SIZE; ++i) {
+        roomCacheSlot = roomCacheOrder[i];
+        if (roomCacheRoom[roomCacheSlot] == playerOverworldPosition && roomCacheWorld[roomCacheSlot] == currentWorldId) {
+            break;
+        }
+    }
+    roomCacheHit = (i != ROOM_CACHE_SIZE);
+    if (!roomCacheHit) {
+        --i;
+    }
+    // Either way, this slot is now the most recently used one; move it to the front.
+    for (; i != 0; --i) {
+        roomCacheOrder[i] = roomCacheOrder[i - 1];
+    }
+    roomCacheOrder[0] = roomCacheSlot;
+    roomCacheSlotMap = &roomCacheMap[roomCacheSlot * ROOM_CACHE_MAP_BYTES];
+    roomCacheSlotCollision = &roomCacheCollision[roomCacheSlot * MAP_COLLISION_BYTES];
+
+    if (roomCacheHit) {
+        // We've been here recently, so everything below has already been done. Just copy it back out. (The same way
+        // as from the map's bank: the tiles and sprite count, then however many sprites that says there are.)
+        memcpy(currentMap, roomCacheSlotMap, MAP_DATA_SPRITE_START);
+        memcpy(&currentMap[MAP_DATA_SPRITE_START], roomCacheSlotMap + MAP_DATA_SPRITE_START, currentMap[MAP_DATA_SPRITE_COUNT] << 1);
+        memcpy(currentMapCollision, roomCacheSlotCollision, MAP_COLLISION_BYTES);
+        currentRoomSpritePersistStart = roomCacheSpritePersistStart[roomCacheSlot];
+        return;
+    }
     
-    // Need to switch to the bank that stores this map data.
-    bank_push(currentWorldId);
-    memcpy(currentMap, overworld + (playerOverworldPosition << 8), 256);
+    // Big maps are split up into parts, and each part can be in a different bank. (See tools/tmx2c) First, ask the
+    // current world which part this room is in, and where it starts in there. It also tells us where this room's
+    // sprites keep their bits in spritePersistence, counting from the start of the world.
+    worldFindRoom[currentWorldId]();
+    currentRoomSpritePersistStart += worldSpritePersistFirstBit[currentWorldId];
+
+    // Now switch to the bank with that part of the map. Rooms aren't all the same length, (see MAP_DATA_SPRITE_COUNT)
+    // so copy the tiles and the sprite count first, then however many sprites that says there are.
+    bank_push(currentRoomBank);
+    memcpy(currentMap, currentRoomData, MAP_DATA_SPRITE_START);
+    memcpy(&currentMap[MAP_DATA_SPRITE_START], currentRoomData + MAP_DATA_SPRITE_START, currentMap[MAP_DATA_SPRITE_COUNT] << 1);
     bank_pop();
 
-}
\ No newline at end of file
+    // Work out which tiles are solid once, up front, so collision tests during the game are a single bit check.
+    // Each row is 16 tiles, or 2 bytes, so tile i goes in byte (i >> 3), at the bit collisionBitMask[i & 7] gives us.
+    memfill(currentMapCollision, 0, MAP_COLLISION_BYTES);
+    for (i = 0; i != MAP_DATA_TILE_LENGTH; ++i) {
+        if (TILE_IS_SOLID(currentMap[i])) {
+            currentMapCollision[i >> 3] |= collisionBitMask[i & 7];
+        }
+    }
+
+    // Keep all of that in the cache, so it doesn't have to be done again if the player comes back soon.
+    roomCacheWorld[roomCacheSlot] = currentWorldId;
+    roomCacheRoom[roomCacheSlot] = playerOverworldPosition;
+    memcpy(roomCacheSlotMap, currentMap, MAP_DATA_SPRITE_START + (currentMap[MAP_DATA_SPRITE_COUNT] << 1));
+    memcpy(roomCacheSlotCollision, currentMapCollision, MAP_COLLISION_BYTES);
+    roomCacheSpritePersistStart[roomCacheSlot] = currentRoomSpritePersistStart;
+
+}
@@ -1,4 +1,17 @@
 #include "source/configuration/system_constants.h"
 
+// The last few rooms load_map loaded are kept in the extra ram on the cartridge, (WRAM) already copied out of their
+// banks and with their collision worked out. Going back to one of them skips all of that. This is how many rooms to
+// keep; each one uses ROOM_CACHE_MAP_BYTES + MAP_COLLISION_BYTES + 4 bytes of WRAM. When it fills up, the room that
+// was used the longest time ago gets replaced.
+#define ROOM_CACHE_SIZE 8
+// The most bytes of a room we keep: the tiles, the sprite count, and 2 bytes for each sprite.
+#define ROOM_CACHE_MAP_BYTES (MAP_DATA_SPRITE_START + (MAP_MAX_SPRITES << 1))
+// Put in roomCacheWorld for slots that don't have a room in them yet.
+#define ROOM_CACHE_EMPTY 0xff
+
 // Loads the map at the player's current position into the ram variable given. 
-void load_map();
\ No newline at end of file
+void load_map();
+
+// Empties out the room cache. WRAM isn't cleared when the game starts, so this has to be called before load_map is.
+void clear_room_cache();
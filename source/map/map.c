@@ -22,9 +22,10 @@ unsigned char currentMap[256];
 
 unsigned char assetTable[0x38];
 
-unsigned char currentMapSpriteData[(16 * MAP_MAX_SPRITES)];
+unsigned char currentMapSpriteData[(16 * MAP_SPRITE_SLOT_COUNT)];
 
-unsigned char currentMapSpritePersistance[64];
+unsigned char spritePersistence[SPRITE_PERSIST_BYTES];
+unsigned int currentRoomSpritePersistStart;
 
 unsigned char mapScreenBuffer[0x55];
 
@@ -46,49 +47,58 @@ void init_map() {
 // Reusing a few temporary vars for the sprite function below.
 #define currentValue tempInt1
 #define spritePosition tempChar3
-#define spriteDefinitionIndex tempChar4
-#define mapSpriteDataIndex tempChar5
 
 // Load the sprites from the current map
 void load_sprites() {
-    for (i = 0; i != MAP_MAX_SPRITES; ++i) {
+    // Empty out the sprite grid. update_map_sprites puts each sprite back into it the first time it sees it.
+    memfill(spriteGridCellMasks, 0, sizeof(spriteGridCellMasks));
+    memfill(spriteGridCellForSprite, SPRITE_GRID_NO_CELL, MAP_SPRITE_SLOT_COUNT);
+    // The flow field for chasing sprites was for the last room.
+    banked_call(PRG_BANK_MAP_SPRITES, reset_sprite_flow_field);
+
+    // The room tells us how many sprites it has, so we only look at the ones that are really there.
+    for (i = 0; i != currentMap[MAP_DATA_SPRITE_COUNT]; ++i) {
         // Each sprite has just 2 bytes stored. The first is the location, and the 2nd is the sprite id in spriteDefinitions.
-        spriteDefinitionIndex = currentMap[(MAP_DATA_TILE_LENGTH + 1) + (i<<1)]<<SPRITE_DEF_SHIFT;
-        mapSpriteDataIndex = i << MAP_SPRITE_DATA_SHIFT;
-        spritePosition = currentMap[(MAP_DATA_TILE_LENGTH) + (i<<1)];
+        spritePosition = currentMap[MAP_DATA_SPRITE_START + (i<<1)];
+        // Start the sorted list of sprites off in map order; update_map_sprites sorts it from there.
+        spriteSortOrder[i] = i;
 
+        if (!MAP_SPRITE_IS_PERSISTED(i)) {
+            // Map sprites are set up the same way as spawned ones, just in their own slot.
+            spawnedSpriteId = i;
+            spawnSpriteDefinitionId = currentMap[(MAP_DATA_SPRITE_START + 1) + (i<<1)];
 
-        if (spritePosition != 255 && !(currentMapSpritePersistance[playerOverworldPosition] & bitToByte[i])) {
-
-            // Get X converted to our extended 16-bit int size.
-            currentValue = (spritePosition & 0x0f) << 8;
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_X] = (currentValue & 0xff);
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_X+1] = (currentValue >> 8);
-            
-            // Now do the same with Y (Which is already shifted 4 bits with the way we store this)
+            // The position is the tile the sprite is on; the low 4 bits are x and the high 4 bits are y.
             // Note that due to weirdness with the NES and scrolling/the HUD, sprites will appear 1 px above where you'd expect 
             // from this math. The one being subtracted from HUD_PIXEL_HEIGHT adjusts for that pixel.
-
-            currentValue = ((spritePosition & 0xf0) << 4) + ((HUD_PIXEL_HEIGHT-1) << SPRITE_POSITION_SHIFT);
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_Y] = (currentValue & 0xff);
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_Y+1] = (currentValue >> 8);
-
-
-            // Copy the simple bytes from the sprite definition to someplace more easily accessible (and modify-able!)
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_TILE_ID] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_TILE_ID];
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_TYPE] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_TYPE];
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_SIZE_PALETTE];
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_HEALTH] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_HEALTH];
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_ANIMATION_TYPE] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_ANIMATION_TYPE];
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE];
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_MOVE_SPEED] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_MOVE_SPEED];
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_DAMAGE] = spriteDefinitions[spriteDefinitionIndex + SPRITE_DEF_POSITION_DAMAGE];
-
+            spawnSpriteX = (spritePosition & 0x0f) << 4;
+            spawnSpriteY = (spritePosition & 0xf0) + (HUD_PIXEL_HEIGHT-1);
+            banked_call(PRG_BANK_MAP_SPRITES, init_map_sprite);
         } else {
             // Go away
-            currentMapSpriteData[mapSpriteDataIndex + MAP_SPRITE_DATA_POS_TYPE] = SPRITE_TYPE_OFFSCREEN;
+            DESPAWN_MAP_SPRITE(i);
         }
     }
+
+    // The rest of the map's slots are empty in this room.
+    for (; i != MAP_MAX_SPRITES; ++i) {
+        DESPAWN_MAP_SPRITE(i);
+        spriteSortOrder[i] = i;
+    }
+
+    // Nothing has been spawned in a room that just loaded, so every spawn slot is empty and on the free list.
+    spawnedSpriteFreeCount = 0;
+    for (; i != MAP_SPRITE_SLOT_COUNT; ++i) {
+        DESPAWN_MAP_SPRITE(i);
+        spriteSortOrder[i] = i;
+        spawnedSpriteFreeList[spawnedSpriteFreeCount] = i;
+        ++spawnedSpriteFreeCount;
+    }
+    spawnedSpriteFreeMask = 0xff;
+
+    // None of the old room's turns mean anything here, so start a new schedule cycle on the next update.
+    spriteScheduleDirty = 1;
+    spriteScheduleFrame = (1 << spriteScheduleShift) - 1;
 }
 
 // Clears the asset table. Set containsHud to 1 to set the HUD bytes to use palette 4 (will break the coloring logic if you use the
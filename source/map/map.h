@@ -1,11 +1,9 @@
 #include "source/library/bank_helpers.h"
 
 // These files are autogenerated, so they ends up in the `temp` directory.
-// They contain the map data definitions, as well as defines for which bank they are in.
+// They contain the map data definitions. (The bank each map ends up in is defined in `temp/prg_banks.h`.)
 #include "temp/level_overworld.h" 
 
-#define PRG_BANK_MAP_LOGIC 1
-
 // This defines how many pixels to move the screen during each frame of the screen scroll animation.
 // Must be a multiple of 2 (or w`hatever value is set below)
 // 2 = slow, 4 = fast, 8 = very fast, 16 = almost instant
@@ -25,14 +23,34 @@
 // in oam.)
 #define MAP_SPRITE_OAM_SHIFT 4
 
-// Max number of sprites to load from a map tile. Note that this is also coded into the conversion tool that
-// nes-starter-kit uses. 
-// Note: You can bump this to 12, but if a room has more than 8 sprites, the last 4 will not have their state
-// persisted. This means sprites can be duplicated if there are more than 8 on a screen, including hearts or keys. 
-// Also note that there isn't much room for more than that... unless you really know the NES hardware
-// intricately, you probably don't want to touch this one.
+// Max number of sprites to load from a map tile. The makefile passes this to tmx2c too, so it knows how many sprites
+// to keep in each room.
+// Note: You can bump this to 12. (Every sprite on the map gets its own bit in spritePersistence below, so rooms with
+// more than 8 sprites still remember which ones were collected.) There isn't much room for more than that... unless
+// you really know the NES hardware intricately, you probably don't want to go past 12.
 #define MAP_MAX_SPRITES 8
 
+// tmx2c tells us the most sprites any room has; make sure they'll all fit. (If you see this, the map was converted
+// with a different limit; run make again, or pass MAP_MAX_SPRITES to tmx2c if you're running it by hand.)
+#if OVERWORLD_MOST_ROOM_SPRITES > MAP_MAX_SPRITES
+    #error "A room in the overworld has more sprites than MAP_MAX_SPRITES allows."
+#endif
+
+// After the sprites from the map, we keep a few more slots for sprites the game creates while it's running, like
+// arrows, sword swings, or things enemies drop. (See spawn_map_sprite in map_sprites.h) Each slot uses 16 bytes of
+// ram and 4 hardware sprites; the map's sprites and these have to fit in the 56 hardware sprites left after the
+// player and sprite 0, so MAP_MAX_SPRITES + MAP_MAX_SPAWNED_SPRITES can't go past 14.
+#define MAP_MAX_SPAWNED_SPRITES 4
+// The total number of sprite slots. The map's sprites come first, (ids 0 to MAP_MAX_SPRITES-1) then the spawned ones.
+#define MAP_SPRITE_SLOT_COUNT (MAP_MAX_SPRITES + MAP_MAX_SPAWNED_SPRITES)
+
+// Big enough to hold one bit for every sprite slot. (See the sprite grid in map_sprites.h)
+#if MAP_SPRITE_SLOT_COUNT > 8
+    #define MAP_SPRITE_MASK unsigned int
+#else
+    #define MAP_SPRITE_MASK unsigned char
+#endif
+
 // Lookup positions for sprite data in currentMapSpriteData.
 #define MAP_SPRITE_DATA_POS_X                   0
 #define MAP_SPRITE_DATA_POS_Y                   2
@@ -40,29 +58,93 @@
 #define MAP_SPRITE_DATA_POS_SIZE_PALETTE        5
 #define MAP_SPRITE_DATA_POS_ANIMATION_TYPE      6
 #define MAP_SPRITE_DATA_POS_HEALTH              7
-#define MAP_SPRITE_DATA_POS_SLIDE_SPEED         7
 #define MAP_SPRITE_DATA_POS_TILE_ID             8
 #define MAP_SPRITE_DATA_POS_MOVEMENT_TYPE       9
 #define MAP_SPRITE_DATA_POS_CURRENT_DIRECTION   10
 #define MAP_SPRITE_DATA_POS_DIRECTION_TIME      11
-#define MAP_SPRITE_DATA_POS_MOVE_SPEED          12
+// Where a SPRITE_MOVEMENT_SCRIPT sprite is in its script. (A position in spriteScripts; see sprite_scripts.h)
+#define MAP_SPRITE_DATA_POS_SCRIPT_POSITION     12
 #define MAP_SPRITE_DATA_POS_DAMAGE              13
+// How fast the sprite moves, in the same units as its position. (2 bytes) Sprites that slide back and forth use the
+// sign for their direction.
+#define MAP_SPRITE_DATA_POS_SPEED               14
 
 // How many tiles are in the map before we start getting into sprite data.
 #define MAP_DATA_TILE_LENGTH 192
+// Right after the tiles, each room has the number of sprites in it, then 2 bytes for each sprite: the tile it's on,
+// (the low 4 bits are x and the high 4 bits are y) and its id in spriteDefinitions. Rooms are only as long as they
+// need to be, so a room without sprites only uses 1 byte for them.
+#define MAP_DATA_SPRITE_COUNT MAP_DATA_TILE_LENGTH
+#define MAP_DATA_SPRITE_START (MAP_DATA_TILE_LENGTH + 1)
 
 // The current map; usable for collisions/etc
 extern unsigned char currentMap[256];
 
-// Supporting data for sprites; 16 bytes per sprite. Look at the sprite loader function in `map.h` (or the guide) for more details.
-extern unsigned char currentMapSpriteData[(16 * MAP_MAX_SPRITES)];
+// Which tiles in the current room are solid, with 1 bit per tile. (Built by load_map from currentMap, using the tile
+// properties from Tiled.) Each row of 16 tiles is 2 bytes; the first byte is the left half of the row. Bits go from
+// left to right, starting at the top bit. (So 0x80 in byte 0 is the top-left tile) Since 8 tiles of a row are in
+// one byte, you can check a wide object against several tiles at once with a mask.
+// The room itself only needs 24 bytes. The last 8 are always 0, so the few pixels just below the room (which the
+// player can reach right before the screen scrolls) are never solid, and we never read past the end.
+#define MAP_COLLISION_BYTES 32
+extern unsigned char currentMapCollision[MAP_COLLISION_BYTES];
+// Bit masks for each tile in a byte of currentMapCollision. (0x80, 0x40, ... 0x01)
+extern const unsigned char collisionBitMask[8];
+
+// Is the tile at this spot in the map (an index into currentMap, like PLAYER_MAP_POSITION gives you) solid?
+// 0: no, anything else: yes
+#define MAP_INDEX_IS_SOLID(mapIndex) (currentMapCollision[(mapIndex) >> 3] & collisionBitMask[(mapIndex) & 7])
+
+// Lookup tables to turn a pixel on the screen into a spot on the map, built from the constants in system_constants.h.
+// mapTileColumnLookup gives the column (0-15) for an x pixel. mapTileRowLookup gives the first index of the row for
+// a y pixel, taking the HUD into account. (row * 16) Pixels above or below the room get a row past the end of it,
+// (192 or more) which is never solid. Looking these up is much faster than doing the math each time.
+extern const unsigned char mapTileColumnLookup[256];
+extern const unsigned char mapTileRowLookup[256];
+
+// Turn the pixel at x, y on the screen into an index into currentMap. Both need to be unsigned chars. (0-255)
+#define MAP_POSITION_FROM_PIXELS(xPixel, yPixel) (mapTileColumnLookup[(xPixel)] + mapTileRowLookup[(yPixel)])
+
+// Is the pixel at x, y on the screen solid? Both need to be unsigned chars. (0-255)
+#define is_solid(xPixel, yPixel) MAP_INDEX_IS_SOLID(MAP_POSITION_FROM_PIXELS(xPixel, yPixel))
 
-// This stores the state for the 8 sprites on every map screen. Each screen is represented by one byte.
-// We do this by storing 1 bit for each sprite - 0 if not collected, 1 if it collected. We don't re-spawn
-// collected sprites.
-extern unsigned char currentMapSpritePersistance[64];
-
-// The player's position on the world map. 0-7 are first row, 8-15 are 2nd, etc...
+// Supporting data for sprites; 16 bytes per sprite. Look at the sprite loader function in `map.h` (or the guide) for more details.
+extern unsigned char currentMapSpriteData[(16 * MAP_SPRITE_SLOT_COUNT)];
+
+// Every sprite placed on a map gets 1 bit here - 0 if not collected, 1 if it was collected. We don't re-spawn
+// collected sprites. tmx2c counts the sprites in each room, so rooms only use bits for the sprites they really have,
+// packed one after the other, and it tells us where each room's bits start. (eg: overworldSpritePersistStart)
+// Each world's bits come right after the one before it. If you add a world, give it a _SPRITE_PERSIST_FIRST_BIT of
+// the last world's first bit plus that world's _SPRITE_PERSIST_BITS, and use it for SPRITE_PERSIST_BITS.
+#define WORLD_OVERWORLD_SPRITE_PERSIST_FIRST_BIT 0
+#define SPRITE_PERSIST_BITS (WORLD_OVERWORLD_SPRITE_PERSIST_FIRST_BIT + OVERWORLD_SPRITE_PERSIST_BITS)
+// How many bytes that takes. (Rounded up, and never 0, so the array always exists)
+#define SPRITE_PERSIST_BYTES ((SPRITE_PERSIST_BITS >> 3) + 1)
+extern unsigned char spritePersistence[SPRITE_PERSIST_BYTES];
+
+// Which bit in spritePersistence belongs to the first sprite in the current room. load_map sets this up.
+extern unsigned int currentRoomSpritePersistStart;
+
+// Where the room load_map is loading is: which part of its world's map it's in, the bank that part is in, and where
+// the room's data starts. Each world's _find_room function (written by tmx2c) sets these up.
+extern unsigned char currentRoomPart;
+extern unsigned char currentRoomBank;
+extern const unsigned char* currentRoomData;
+
+// The byte and bit in spritePersistence for a sprite in the current room.
+#define MAP_SPRITE_PERSIST_BYTE(spriteId) spritePersistence[(currentRoomSpritePersistStart + (spriteId)) >> 3]
+#define MAP_SPRITE_PERSIST_BIT(spriteId) bitToByte[(currentRoomSpritePersistStart + (spriteId)) & 0x07]
+
+// Was the sprite with this id in the current room collected already? 0: no, anything else: yes
+#define MAP_SPRITE_IS_PERSISTED(spriteId) (MAP_SPRITE_PERSIST_BYTE(spriteId) & MAP_SPRITE_PERSIST_BIT(spriteId))
+
+// Remember that the sprite with this id was collected, so it doesn't come back next time the room loads. Spawned
+// sprites aren't part of the map, so this does nothing for them.
+#define PERSIST_MAP_SPRITE(spriteId) if ((spriteId) < MAP_MAX_SPRITES) { MAP_SPRITE_PERSIST_BYTE(spriteId) |= MAP_SPRITE_PERSIST_BIT(spriteId); }
+
+// The player's position on the world map. Rooms are numbered left to right, then top to bottom, so on a map that is
+// 8 rooms wide, 0-7 are the first row, 8-15 are the 2nd, etc. tmx2c gets the size of the map from Tiled, and defines
+// it as OVERWORLD_WIDTH and OVERWORLD_HEIGHT. Since this is one byte, a world can have at most 256 rooms.
 ZEROPAGE_EXTERN(unsigned char, playerOverworldPosition);
 
 // Load the sprites from the current map into currentMapSpriteData, and the sprite list.
@@ -85,5 +167,8 @@ void do_scroll_screen_transition();
 // Take the value of playerOverworldPosition, and transition onto that screen with a fade animation.
 void do_fade_screen_transition();
 
-// Defines world ids we use, which are also PRG bank ids to save storage and simplify code.
-#define WORLD_OVERWORLD PRG_BANK_MAP_OVERWORLD
+// Defines world ids we use. These count up from 0, and are positions in the worldFindRoom and
+// worldSpritePersistFirstBit tables in load_map.c. (They used to be the bank each world was in, but a world can be
+// spread over several banks now.) If you add a world, give it the next id, bump WORLD_COUNT, and add it to both tables.
+#define WORLD_OVERWORLD 0
+#define WORLD_COUNT 1
@@ -1,6 +1,5 @@
 
 // Draws and handles a very simple pause screen.
-#define PRG_BANK_CREDITS_MENU 2
 
 // Draw a screen that says "you won!"
 void draw_win_screen();
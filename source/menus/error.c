@@ -16,6 +16,8 @@ const char* ERR_RECURSION_DEPTH = "Bank Recursion Depth Error";
 const char* ERR_RECURSION_DEPTH_EXPLANATION = "Too many requests were made to bank_call from other requests. Only up to " STR(MAX_RECURSION_DEPTH) " calls can be made.";
 const char* ERR_UNKNOWN_SPRITE_SIZE = "Unknown Sprite Size";
 const char* ERR_UNKNOWN_SPRITE_SIZE_EXPLANATION = "A sprite definition has a size that the engine does not recognize.";
+const char* ERR_NO_INPUT_RECORDING = "No Input Recording";
+const char* ERR_NO_INPUT_RECORDING_EXPLANATION = "The game was built to replay input, but no recording was found in WRAM. Load a .sav file from a recording first.";
 
 char buffer[10];
 
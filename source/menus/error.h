@@ -9,11 +9,10 @@ extern const char* ERR_RECURSION_DEPTH;
 extern const char* ERR_RECURSION_DEPTH_EXPLANATION;
 extern const char* ERR_UNKNOWN_SPRITE_SIZE;
 extern const char* ERR_UNKNOWN_SPRITE_SIZE_EXPLANATION;
+extern const char* ERR_NO_INPUT_RECORDING;
+extern const char* ERR_NO_INPUT_RECORDING_EXPLANATION;
 
 
-// What bank do we wanna put this stuff in?
-#define PRG_BANK_ERROR 1
-
 // Spit out an error screen and crash the rom.
 // errorId: A string describing the error. Use one of the constants in error.c/here
 // errorDescription: Some text describing the error in detail. Alternatively, pass NULL.
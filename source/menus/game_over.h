@@ -1,3 +1 @@
-#define PRG_BANK_GAME_OVER 2
-
 void draw_game_over_screen();
\ No newline at end of file
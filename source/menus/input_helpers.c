@@ -3,17 +3,21 @@
 #include "source/neslib_asm/neslib.h"
 #include "source/library/bank_helpers.h"
 #include "source/menus/input_helpers.h"
+#include "source/library/input_recorder.h"
 
 CODE_BANK(PRG_BANK_MENU_INPUT_HELPERS);
 void wait_for_start() {
     while (1) {
         lastControllerState = controllerState;
-        controllerState = pad_poll(0);
+        controllerState = input_pad_poll(0);
 
         // If Start is pressed now, and was not pressed before...
         if (controllerState & PAD_START && !(lastControllerState & PAD_START)) {
             break;
         }
 
+        // Only check once per frame. There's no reason to spin faster than the game draws, and it keeps input recordings
+        // in step with the frames they were recorded on.
+        ppu_wait_frame();
     }
 }
\ No newline at end of file
@@ -1,4 +1,2 @@
-#define PRG_BANK_MENU_INPUT_HELPERS 2
-
 // Helper method to wait for the player to press start.
 void wait_for_start();
\ No newline at end of file
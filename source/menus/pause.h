@@ -1,6 +1,4 @@
 // Draws and handles a very simple pause screen.
-#define PRG_BANK_PAUSE_MENU 2
-
 
 void draw_pause_screen();
 
@@ -6,6 +6,7 @@
 #include "source/menus/text_helpers.h"
 #include "source/graphics/palettes.h"
 #include "source/configuration/game_info.h"
+#include "source/library/input_recorder.h"
 
 CODE_BANK(PRG_BANK_TITLE);
 
@@ -35,7 +36,11 @@ void draw_title_screen() {
 }
 
 void handle_title_input() {
-	if (pad_trigger(0) & PAD_START) {
+	lastControllerState = controllerState;
+	controllerState = input_pad_poll(0);
+
+	// If Start is pressed now, and was not pressed before...
+	if (controllerState & PAD_START && !(lastControllerState & PAD_START)) {
 		gameState = GAME_STATE_POST_TITLE;
 	}
 }
\ No newline at end of file
@@ -1,4 +1,2 @@
-#define PRG_BANK_TITLE 2
-
 void draw_title_screen();
 void handle_title_input();
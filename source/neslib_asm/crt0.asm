@@ -22,6 +22,7 @@ FT_SFX_STREAMS			= 4			;number of sound effects played at once, 1..4
     .include "tools/cc65/asminc/zeropage.inc"
 
 	.export _frameCount
+	.export _oamBuffer
 
 
 
@@ -48,6 +49,8 @@ CTRL_PORT2	=$4017
 OAM_BUF		=$0200
 PAL_BUF		=$01c0
 
+_oamBuffer	=OAM_BUF		; The same buffer, for C code to use with an extern
+
 
 
 .segment "ZEROPAGE"
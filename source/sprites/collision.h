@@ -1,10 +1,22 @@
-#define FIRST_WALKABLE_SPRITE 0
-#define LAST_WALKABLE_SPRITE 23
-#define FIRST_SOLID_SPRITE 24
-#define LAST_SOLID_SPRITE 47
+#include "temp/level_overworld.h"
 
-#define PRG_BANK_SPRITE_COLLISION 2
+// Each tile can have collision properties, which you set in Tiled: select a tile in the "Overworld Tiles" tileset,
+// and add a bool property with one of the names below. (solid, hazard, water, slow, one_way) tmx2c turns these into
+// a table with one byte per tile, using these bits. The tile's palette doesn't matter; all 4 copies of a tile share
+// the same properties.
+// NOTE: Only solid is used by the engine right now. The rest are there for you to build on!
+// To check a tile from your own code, use TILE_IS_SOLID or TILE_COLLISION_FLAGS below.
+#define TILE_COLLISION_SOLID    0x01
+#define TILE_COLLISION_HAZARD   0x02
+#define TILE_COLLISION_WATER    0x04
+#define TILE_COLLISION_SLOW     0x08
+#define TILE_COLLISION_ONE_WAY  0x10
 
-// Test whether or not a given tile should stop player movement. 0: no collision, 1: collision
-// This function has side effects for special tiles, but those side effects are ignored for non-players.
-unsigned char test_collision(unsigned char tileId, unsigned char isPlayer);
\ No newline at end of file
+// The table tmx2c built from the tileset. (It lives in the fixed bank, so any code can read it.)
+#define TILE_COLLISION_TABLE overworldTileCollision
+
+// Get all of the TILE_COLLISION_ bits for a tile from the map. This is a single lookup, so it is much faster than
+// calling a function - use it for anything that runs every frame.
+#define TILE_COLLISION_FLAGS(tileId) (TILE_COLLISION_TABLE[(tileId) & 0x3f])
+// Is the given tile from the map solid? 0: no, anything else: yes
+#define TILE_IS_SOLID(tileId) (TILE_COLLISION_FLAGS(tileId) & TILE_COLLISION_SOLID)
@@ -1,13 +1,14 @@
 #include "source/neslib_asm/neslib.h"
 #include "source/globals.h"
 #include "source/configuration/system_constants.h"
+#include "source/map/map.h"
 #include "source/sprites/map_sprites.h"
 #include "source/sprites/player.h"
 #include "source/sprites/sprite_definitions.h"
-#include "source/map/map.h"
 #include "source/library/bank_helpers.h"
 #include "source/menus/error.h"
 #include "source/sprites/collision.h"
+#include "source/sprites/sprite_scripts.h"
 
 CODE_BANK(PRG_BANK_MAP_SPRITES);
 
@@ -21,298 +22,995 @@ CODE_BANK(PRG_BANK_MAP_SPRITES);
 #define sprY8 tempChar8
 #define sprX tempInt1
 #define sprY tempInt2
-// NOTE: width = height for our examples, so both are set to the same value.
-// If you change this, be sure to assign it in the for loop below as well.
-#define currentSpriteFullWidth tempInt3
-#define currentSpriteFullHeight tempInt3
-// Same story, but corrected for tile collisions
-// TODO: What if, instead of storing width, we stored the Y coordinate of the rightmost and bottom points?
-#define currentSpriteFullTileCollisionWidth tempInt4
-#define currentSpriteFullTileCollisionHeight tempInt4
+// The spot on the edge of the sprite's tile hitbox we're testing against the map, in the same units as sprX/sprY.
+#define spriteTileTestX tempInt3
+#define spriteTileTestY tempInt4
+#define currentSpriteSpeed tempInt5
+// How many times further than its speed the current sprite should move this turn, as a shift. (See SCALE_SPRITE_SPEED)
+// Only used in update_map_sprites and the movement functions.
+#define currentSpriteMoveShift tempChar5
+#define currentSpriteGridCell tempChar9
+// The attributes for the sprite's tiles in OAM: its palette, and OAM_FLIP_H if it's mirrored.
+#define currentSpriteAttributes tempChara
+// Only used while drawing the sprite, before currentSpriteGridCell needs tempChar9.
+#define currentSpriteFlipColumn tempChar9
 
+ZEROPAGE_DEF(unsigned char, playerSpriteCollisionCount);
+unsigned char playerSpriteCollisionList[MAP_SPRITE_SLOT_COUNT];
 
+MAP_SPRITE_MASK spriteGridCellMasks[SPRITE_GRID_CELL_COUNT];
+unsigned char spriteGridCellForSprite[MAP_SPRITE_SLOT_COUNT];
 
-ZEROPAGE_DEF(unsigned char, lastPlayerSpriteCollisionId);
+unsigned char spawnSpriteDefinitionId;
+unsigned char spawnSpriteX;
+unsigned char spawnSpriteY;
+unsigned char spawnedSpriteId;
+unsigned char spawnedSpriteFreeList[MAP_MAX_SPAWNED_SPRITES];
+unsigned char spawnedSpriteFreeCount;
+unsigned char spawnedSpriteFreeMask;
+// init_map_sprite has its own variables instead of using the temp ones, so it's safe to spawn sprites from anywhere,
+// even in the middle of a loop that uses them.
+unsigned char spawnSpriteDataIndex;
+unsigned int spawnSpriteDefinitionIndex;
+int spawnSpriteSpeed;
 
-void update_map_sprites() {
-    lastPlayerSpriteCollisionId = NO_SPRITE_HIT;
-    
-    // To save some cpu time, we only update sprites every other frame - even sprites on even frames, odd sprites on odd frames.
-    for (i = 0; i < MAP_MAX_SPRITES; ++i) {
-        currentMapSpriteIndex = i << MAP_SPRITE_DATA_SHIFT;
-        
-        // This switches what position we write the sprite to regularly, so we can maintain a flicker effect instead
-        // of having the sprite just randomly disappear. We use 0x02 so it flips every other frame, so flickering is less
-        // likely to fail if we lose a frame. (If you have enough sprites to flicker, you may also see slowdown.)
-        if (frameCount & 0x02) {
-            oamMapSpriteIndex = (MAP_MAX_SPRITES-i-1) << MAP_SPRITE_OAM_SHIFT;
-        } else {
-            oamMapSpriteIndex = i << MAP_SPRITE_OAM_SHIFT;
+unsigned char spriteTileHitboxLeft[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteTileHitboxTop[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteTileHitboxRight[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteTileHitboxBottom[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteHitboxLeft[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteHitboxTop[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteHitboxWidth[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteHitboxHeight[MAP_SPRITE_SLOT_COUNT];
+
+unsigned char spriteSortOrder[MAP_SPRITE_SLOT_COUNT];
+// Where in spriteSortOrder find_sprite_sprite_collisions starts its next sweep. This only moves when a pass runs into
+// SPRITE_SPRITE_COLLISION_MAX_PAIRS.
+unsigned char spriteCollisionSweepStart;
+
+unsigned char spriteScheduleShift;
+unsigned char spriteSchedulePhase[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteScheduleDirty;
+MAP_SPRITE_MASK spriteNearPlayerMask;
+// The frame of the cycle we're on, and how many full cycles we've been through. (Only the lowest bit of that matters)
+unsigned char spriteScheduleFrame;
+unsigned char spriteScheduleCycle;
+// How much work each frame of the cycle has been given so far, and how much there is in total. schedule_map_sprites
+// works these out from scratch, and schedule_new_map_sprite and update_map_sprites keep them up to date in between.
+unsigned int spriteSchedulePhaseCost[1 << SPRITE_AI_MAX_SCHEDULE_SHIFT];
+unsigned int spriteScheduleTotalCost;
+
+// The flow field lives in the extra ram on the cartridge, since it's too big to fit in the regular kind. It gets
+// thrown away for every room, so it doesn't matter that this ram isn't cleared when the game starts.
+WRAM_ARRAY_DEF(unsigned char, spriteFlowDirection, MAP_DATA_TILE_LENGTH);
+WRAM_ARRAY_DEF(unsigned char, spriteFlowSearchId, MAP_DATA_TILE_LENGTH);
+// The tiles the search has reached, but hasn't looked around from yet, in the order it reached them. Each tile only
+// goes in once per search, so this never needs to be bigger than the room.
+WRAM_ARRAY_DEF(unsigned char, spriteFlowQueue, MAP_DATA_TILE_LENGTH);
+unsigned char spriteFlowQueueStart;
+unsigned char spriteFlowQueueEnd;
+unsigned char spriteFlowCurrentSearchId;
+unsigned char spriteFlowTargetTile;
+unsigned char spriteFlowActive;
+
+unsigned char spriteOamState[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteOamCache[MAP_SPRITE_SLOT_COUNT << MAP_SPRITE_OAM_SHIFT];
+// Which flicker order (frameCount & 0x02) we used last time, and whether it's different this time.
+unsigned char spriteOamFlicker;
+unsigned char spriteOamFlickerChanged;
+
+unsigned char spriteAnimationSequenceStart[SPRITE_ANIMATION_COUNT];
+// Where each sprite is in its animation sequence, (a position in spriteAnimationSequences) and how many more frames
+// to show that frame for.
+unsigned char spriteAnimationFrame[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteAnimationTime[MAP_SPRITE_SLOT_COUNT];
+// Where each sprite's hitbox was this frame, in pixels, and how wide it is. (0 for sprites that can't bump into
+// anything) update_map_sprites fills these in so find_sprite_sprite_collisions doesn't have to work them out again.
+// (The height doesn't change, so that comes straight from spriteHitboxHeight.)
+unsigned char spriteCollisionLeft[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteCollisionTop[MAP_SPRITE_SLOT_COUNT];
+unsigned char spriteCollisionWidth[MAP_SPRITE_SLOT_COUNT];
+
+// The bit for each sprite in spriteGridCellMasks. (There's room for up to 16 sprites.)
+const unsigned int spriteGridBit[16] = {
+    0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+    0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000
+};
+
+#define animationSequenceId tempChar1
+#define animationSequencePosition tempChar2
+void init_sprite_animations() {
+    // Walk through the list of sequences, and note where each one starts. (Right after the end of the last one)
+    spriteAnimationSequenceStart[0] = 0;
+    animationSequencePosition = 0;
+    for (animationSequenceId = 1; animationSequenceId != SPRITE_ANIMATION_COUNT; ++animationSequenceId) {
+        while (spriteAnimationSequences[animationSequencePosition + 1] != 0) {
+            animationSequencePosition += 2;
         }
-        oamMapSpriteIndex += FIRST_ENEMY_SPRITE_OAM_INDEX;
-        sprX = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X + 1]) << 8));
-        sprY = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y + 1]) << 8));
-        currentSpriteSize = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_SIZE_MASK; 
-        currentSpriteTileId = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_TILE_ID];
-                
-        // NOTE: we're only setting currentSpriteFullWidth here because our code assumes everything is a square. If you 
-        // change that, be sure to change currentSpriteFullHeight here, and give it a new variable above.
-        if ((currentMapSpriteData[(currentMapSpriteIndex) + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_SIZE_MASK) == SPRITE_SIZE_8PX_8PX) {
-            currentSpriteFullWidth = NES_SPRITE_WIDTH << PLAYER_POSITION_SHIFT;
-        } else {
-            currentSpriteFullWidth = NES_SPRITE_WIDTH << (PLAYER_POSITION_SHIFT+1);
+        // Skip over the SPRITE_ANIMATION_LOOP too.
+        animationSequencePosition += 2;
+        spriteAnimationSequenceStart[animationSequenceId] = animationSequencePosition;
+    }
+}
+
+void spawn_map_sprite() {
+    if (spawnedSpriteFreeCount == 0) {
+        spawnedSpriteId = NO_SPRITE_SLOT;
+        return;
+    }
+    // Take the last free slot off the list.
+    --spawnedSpriteFreeCount;
+    spawnedSpriteId = spawnedSpriteFreeList[spawnedSpriteFreeCount];
+    spawnedSpriteFreeMask &= ~bitToByte[spawnedSpriteId - MAP_MAX_SPRITES];
+
+    init_map_sprite();
+}
+
+void init_map_sprite() {
+    spawnSpriteDataIndex = spawnedSpriteId << MAP_SPRITE_DATA_SHIFT;
+    spawnSpriteDefinitionIndex = spawnSpriteDefinitionId << SPRITE_DEF_SHIFT;
+
+    // Positions are 16 bits; the high byte is the pixel, and the low byte (the part of a pixel) starts at 0.
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_X] = 0;
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_X+1] = spawnSpriteX;
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_Y] = 0;
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_Y+1] = spawnSpriteY;
+
+    // Speeds are stored in 16ths of a pixel in the definitions, so they fit in 1 byte. Convert to our units.
+    // Sprites that slide back and forth store a signed speed in a different spot from wandering sprites.
+    if (
+        spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE] == SPRITE_MOVEMENT_RANDOM_WANDER ||
+        spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE] == SPRITE_MOVEMENT_CHASE ||
+        spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE] == SPRITE_MOVEMENT_SCRIPT
+    ) {
+        spawnSpriteSpeed = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVE_SPEED] << SPRITE_DEF_SPEED_SHIFT;
+    } else {
+        spawnSpriteSpeed = (signed char)spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_SLIDE_SPEED] << SPRITE_DEF_SPEED_SHIFT;
+    }
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_SPEED] = (spawnSpriteSpeed & 0xff);
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_SPEED+1] = (spawnSpriteSpeed >> 8);
+
+    // Copy the simple bytes from the sprite definition to someplace more easily accessible (and modify-able!)
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_TILE_ID] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_TILE_ID];
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_TYPE] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_TYPE];
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_SIZE_PALETTE];
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_HEALTH] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_HEALTH];
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_ANIMATION_TYPE] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_ANIMATION_TYPE];
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE];
+    currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_DAMAGE] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_DAMAGE];
+
+    // Scripted sprites start at the top of their script, facing down, with no command in progress.
+    if (spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE] == SPRITE_MOVEMENT_SCRIPT) {
+        currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_SCRIPT_POSITION] = spriteScriptStart[spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_SCRIPT_ID]];
+        currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME] = 0;
+        currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_DOWN;
+    }
+
+    // Copy the hitboxes too. The one for touching things is turned into a width and height here, so nobody has to
+    // work it out later.
+    spriteTileHitboxLeft[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_TILE_HITBOX_LEFT];
+    spriteTileHitboxTop[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_TILE_HITBOX_TOP];
+    spriteTileHitboxRight[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_TILE_HITBOX_RIGHT];
+    spriteTileHitboxBottom[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_TILE_HITBOX_BOTTOM];
+    spriteHitboxLeft[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_HITBOX_LEFT];
+    spriteHitboxTop[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_HITBOX_TOP];
+    spriteHitboxWidth[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_HITBOX_RIGHT] - spriteHitboxLeft[spawnedSpriteId] + 1;
+    spriteHitboxHeight[spawnedSpriteId] = spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_HITBOX_BOTTOM] - spriteHitboxTop[spawnedSpriteId] + 1;
+
+    // A new sprite means more work to spread out; give it a turn in the schedule. It also needs to be drawn.
+    schedule_new_map_sprite();
+    REDRAW_MAP_SPRITE(spawnedSpriteId);
 
-            // For 16x16 sprites, we reduce the sprite hitbox a bit. We also subtract this offset from X/y in-place
-            currentSpriteFullTileCollisionWidth = currentSpriteFullWidth - (2*SPRITE_TILE_HITBOX_OFFSET);
+    // Start the sprite's animation from the first frame.
+    START_SPRITE_ANIMATION(
+        spriteAnimationFrame[spawnedSpriteId],
+        spriteAnimationTime[spawnedSpriteId],
+        spriteAnimationSequenceStart[currentMapSpriteData[spawnSpriteDataIndex + MAP_SPRITE_DATA_POS_ANIMATION_TYPE]]
+    );
+}
 
+// ===== Sprite behaviors
+// Each animation and movement type is its own function, and update_map_sprites calls the right one for each sprite
+// using the tables below. They all work on the variables update_map_sprites sets up for the current sprite.
+// (currentMapSpriteIndex, sprX, sprY, currentSpriteTileId, etc) Animation functions change currentSpriteTileId,
+// and movement functions move the sprite, updating sprX and sprY to match.
+
+// The edges of the current sprite's tile hitbox, in the same units as sprX and sprY. Add these to sprX/sprY to get the
+// spot on the map to test.
+#define SPRITE_TILE_HITBOX_LEFT_EDGE (spriteTileHitboxLeft[i] << SPRITE_POSITION_SHIFT)
+#define SPRITE_TILE_HITBOX_TOP_EDGE (spriteTileHitboxTop[i] << SPRITE_POSITION_SHIFT)
+#define SPRITE_TILE_HITBOX_RIGHT_EDGE (spriteTileHitboxRight[i] << SPRITE_POSITION_SHIFT)
+#define SPRITE_TILE_HITBOX_BOTTOM_EDGE (spriteTileHitboxBottom[i] << SPRITE_POSITION_SHIFT)
+
+// Sprite speeds are how far the sprite moves every 2 frames. The scheduler might give a sprite a turn every frame, or
+// only every 4th frame, so the movement functions scale the speed to match. (This is at most 2 steps either way; see
+// SPRITE_AI_MAX_SCHEDULE_SHIFT)
+#define SCALE_SPRITE_SPEED() \
+    if (currentSpriteMoveShift == 0) { \
+        currentSpriteSpeed >>= 1; \
+    } else if (currentSpriteMoveShift == 2) { \
+        currentSpriteSpeed <<= 1; \
+    }
+
+// Used for sprites that don't animate, or don't move.
+void sprite_behavior_none() {
+}
+
+// Play the sprite's animation sequence from spriteAnimationSequences. Each sprite keeps its own place in the sequence,
+// so this is just a countdown most frames.
+void animate_sprite_sequence() {
+    STEP_SPRITE_ANIMATION(
+        spriteAnimationFrame[i],
+        spriteAnimationTime[i],
+        spriteAnimationSequenceStart[currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_ANIMATION_TYPE]]
+    );
+    if (currentSpriteSize == SPRITE_SIZE_16PX_16PX) {
+        // 16x16 sprites use 2 tiles across for each frame.
+        currentSpriteTileId += spriteAnimationSequences[spriteAnimationFrame[i]] << 1;
+    } else {
+        currentSpriteTileId += spriteAnimationSequences[spriteAnimationFrame[i]];
+    }
+}
+
+// Face the way the sprite is going, and flip between 2 tiles for that direction.
+void animate_sprite_full() {
+    // This is for sprites that can face up/down/left/right, and are animated while they do so.
+    currentSpriteData = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION];
+    if (currentSpriteData == SPRITE_DIRECTION_LEFT) {
+        if (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_FLIP_LEFT) {
+            // Use the right-facing tiles, and have the NES mirror them for us.
+            currentSpriteTileId += currentSpriteSize == SPRITE_SIZE_16PX_16PX ? 0x20 : 0x10;
+            currentSpriteAttributes |= OAM_FLIP_H;
+        } else {
+            currentSpriteTileId += currentSpriteSize == SPRITE_SIZE_16PX_16PX ? 0x24 : 0x12;
         }
+    } else if (currentSpriteData == SPRITE_DIRECTION_RIGHT) {
+        currentSpriteTileId += currentSpriteSize == SPRITE_SIZE_16PX_16PX ? 0x20 : 0x10;
+    } else if (currentSpriteData == SPRITE_DIRECTION_UP) {
+        currentSpriteTileId += currentSpriteSize == SPRITE_SIZE_16PX_16PX ? 0x04 : 0x02;
+    } // Else, you're facing down, which conveniently is in position zero. So, do nothing!
 
+    // Next, play the animation for that direction.
+    animate_sprite_sequence();
+}
 
-        if (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_TYPE] == SPRITE_TYPE_OFFSCREEN) {
-            // Hide it and move on.
-            oam_spr(SPRITE_OFFSCREEN, SPRITE_OFFSCREEN, 0, 0, oamMapSpriteIndex);
-            oam_spr(SPRITE_OFFSCREEN, SPRITE_OFFSCREEN, 0, 0, oamMapSpriteIndex + 4);
-            oam_spr(SPRITE_OFFSCREEN, SPRITE_OFFSCREEN, 0, 0, oamMapSpriteIndex + 8);
-            oam_spr(SPRITE_OFFSCREEN, SPRITE_OFFSCREEN, 0, 0, oamMapSpriteIndex + 12);
-            continue;
+// Slide left and right, turning around at walls.
+void move_sprite_left_right() {
+    // Get the speed to travel at
+    currentSpriteSpeed = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8);
+    SCALE_SPRITE_SPEED();
+
+    // Add speed in
+    sprX += currentSpriteSpeed;
+    // Test the side of the tile hitbox we're moving toward: the right if the speed is positive, else the left.
+    if (currentSpriteSpeed > 0) {
+        spriteTileTestX = sprX + SPRITE_TILE_HITBOX_RIGHT_EDGE;
+    } else {
+        spriteTileTestX = sprX + SPRITE_TILE_HITBOX_LEFT_EDGE;
+    }
+    if (SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_TOP_EDGE) || SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_BOTTOM_EDGE)) {
+        // Never mind... leave X position alone for now
+        sprX -= currentSpriteSpeed;
+
+        // And... flip the direction! (We flip the speed we have stored, not the scaled one we just used.)
+        currentSpriteSpeed = 0 - (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8));
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] = (currentSpriteSpeed & 0xff);
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED+1] = (currentSpriteSpeed >> 8);
+    } else {
+        // No collision! Move the sprite over.
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
+    }
+}
+
+// Slide up and down, turning around at walls.
+void move_sprite_up_down() {
+    // Get the speed to travel at
+    currentSpriteSpeed = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8);
+    SCALE_SPRITE_SPEED();
+
+    // Add speed in
+    sprY += currentSpriteSpeed;
+    // Test the side of the tile hitbox we're moving toward: the bottom if the speed is positive, else the top.
+    if (currentSpriteSpeed > 0) {
+        spriteTileTestY = sprY + SPRITE_TILE_HITBOX_BOTTOM_EDGE;
+    } else {
+        spriteTileTestY = sprY + SPRITE_TILE_HITBOX_TOP_EDGE;
+    }
+    if (SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_LEFT_EDGE, spriteTileTestY) || SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_RIGHT_EDGE, spriteTileTestY)) {
+        // Never mind... leave Y position alone for now
+        sprY -= currentSpriteSpeed;
+
+        // And... flip the direction! (We flip the speed we have stored, not the scaled one we just used.)
+        currentSpriteSpeed = 0 - (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8));
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] = (currentSpriteSpeed & 0xff);
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED+1] = (currentSpriteSpeed >> 8);
+    } else {
+        // No collision! Move the sprite over.
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
+    }
+}
+
+// Wander around in random directions, stopping at walls.
+void move_sprite_random_wander() {
+    // Okay, we're going to simulate an intelligent enemy. 
+
+    // First, how long have we been travelling in the same direction? Is it time for a swap?
+    if (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME] == 0) {
+        // Yep. Figure out if direction is: none, left, right, up, or down we do this by getting a random number
+        // between 0 and 8 with bit masking. If it's 0, stop for a bit... if it's 1, left... 4 down, or 5-7, maintain.
+        switch (rand8() & 0x07) {
+            case 0:
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_STATIONARY;
+                break;
+            case 1:
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_LEFT;
+                break;
+            case 2:
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_RIGHT;
+                break;
+            case 3: 
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_UP;
+                break;
+            case 4:
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_DOWN;
+                break;
+            default:
+                // Do nothing - just carry on in the direction you're going for another cycle.
+                break;
         }
+        // NOTE: This counts turns, not frames, so sprites in a crowded room keep going the same way a little longer.
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME] = 20 + (rand8() & 31);
+    } else {
+        --currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME];
+    }
 
-        switch (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_ANIMATION_TYPE]) {
-            case SPRITE_ANIMATION_SWAP:
+    // Get the sprite's speed. We'll then add/subtract it from sprX and sprY
+    currentSpriteSpeed = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8);
+    SCALE_SPRITE_SPEED();
+    switch (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION]) {
+        case SPRITE_DIRECTION_LEFT:
 
-                if (currentSpriteSize == SPRITE_SIZE_8PX_8PX) {
-                    currentSpriteTileId += ((frameCount & 0x10) >> 4);
-                } else if (currentSpriteSize == SPRITE_SIZE_16PX_16PX) {
-                    currentSpriteTileId += ((frameCount & 0x10) >> 3);
-                }
+            // Would this take us off the left of the screen? (We test this before moving, since positions are
+            // unsigned; going past 0 would wrap around to the right side of the screen.)
+            if ((unsigned int)sprX < (SCREEN_EDGE_LEFT << SPRITE_POSITION_SHIFT) + currentSpriteSpeed) {
+                break;
+            }
+            sprX -= currentSpriteSpeed;
+            spriteTileTestX = sprX + SPRITE_TILE_HITBOX_LEFT_EDGE;
 
+            // If we have not collided, save the new position. Else, just exit.
+            if (!SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_TOP_EDGE) && !SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_BOTTOM_EDGE)) {
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
+            } else {
+                // Roll back the position since we use sprX to place the sprite
+                sprX += currentSpriteSpeed;
+            }
+
+            break;
+        case SPRITE_DIRECTION_RIGHT:
+            // Would this take us off the right of the screen?
+            if ((unsigned int)sprX > (SCREEN_EDGE_RIGHT << SPRITE_POSITION_SHIFT) - SPRITE_TILE_HITBOX_RIGHT_EDGE - currentSpriteSpeed) {
                 break;
-            case SPRITE_ANIMATION_SWAP_FAST:
-                if (currentSpriteSize == SPRITE_SIZE_8PX_8PX) {
-                    currentSpriteTileId += ((frameCount & 0x08) >> 3);
-                } else if (currentSpriteSize == SPRITE_SIZE_16PX_16PX) {
-                    currentSpriteTileId += ((frameCount & 0x08) >> 2);
-                }
+            }
+            sprX += currentSpriteSpeed;
+            spriteTileTestX = sprX + SPRITE_TILE_HITBOX_RIGHT_EDGE;
+
+            // If we have not collided, save the new position. Else, just exit.
+            if (!SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_TOP_EDGE) && !SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_BOTTOM_EDGE)) {
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
+            } else {
+                // Roll back the position since we use sprX to place the sprite
+                sprX -= currentSpriteSpeed;
+            }
+            break;
+        case SPRITE_DIRECTION_UP:
+            if ((unsigned int)sprY < (SCREEN_EDGE_TOP << SPRITE_POSITION_SHIFT) + currentSpriteSpeed) {
                 break;
-            case SPRITE_ANIMATION_FULL:
-                // This is for sprites that can face up/down/left/right, and are animated while they do so.
-                currentSpriteData = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION];
-                if (currentSpriteData == SPRITE_DIRECTION_LEFT) {
-                    currentSpriteTileId += currentSpriteSize == SPRITE_SIZE_16PX_16PX ? 0x24 : 0x12;
-                } else if (currentSpriteData == SPRITE_DIRECTION_RIGHT) {
-                    currentSpriteTileId += currentSpriteSize == SPRITE_SIZE_16PX_16PX ? 0x20 : 0x10;
-                } else if (currentSpriteData == SPRITE_DIRECTION_UP) {
-                    currentSpriteTileId += currentSpriteSize == SPRITE_SIZE_16PX_16PX ? 0x04 : 0x02;
-                } // Else, you're facing down, which conveniently is in position zero. So, do nothing!
-
-                // Next, let's animate based on the current frame. 
-                if (currentSpriteSize == SPRITE_SIZE_16PX_16PX) {
-                    currentSpriteTileId += (frameCount & 0x10) >> 3;
-                } else {
-                    currentSpriteTileId += (frameCount & 0x08) >> 3;
-                }
+            }
+            sprY -= currentSpriteSpeed;
+            spriteTileTestY = sprY + SPRITE_TILE_HITBOX_TOP_EDGE;
+
+            // If we have not collided, save the new position. Else, just exit.
+            if (!SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_LEFT_EDGE, spriteTileTestY) && !SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_RIGHT_EDGE, spriteTileTestY)) {
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
+            } else {
+                // Roll back the position since we use sprY to place the sprite
+                sprY += currentSpriteSpeed;
+            }
+
+            break;
+        case SPRITE_DIRECTION_DOWN:
+            if ((unsigned int)sprY > (SCREEN_EDGE_BOTTOM << SPRITE_POSITION_SHIFT) - SPRITE_TILE_HITBOX_BOTTOM_EDGE - currentSpriteSpeed) {
+                break;
+            }
+            sprY += currentSpriteSpeed;
+            spriteTileTestY = sprY + SPRITE_TILE_HITBOX_BOTTOM_EDGE;
+
+            // If we have not collided, save the new position. Else, just exit.
+            if (!SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_LEFT_EDGE, spriteTileTestY) && !SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_RIGHT_EDGE, spriteTileTestY)) {
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
+                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
+            } else {
+                // Roll back the position since we use sprY to place the sprite
+                sprY -= currentSpriteSpeed;
+            }
+
+            break;
+    }
+}
+
+// Move pos toward target by currentSpriteSpeed, stopping right on it instead of going past.
+#define MOVE_SPRITE_TOWARD(pos, target) \
+    if ((unsigned int)(pos) < (unsigned int)(target)) { \
+        if ((unsigned int)((target) - (pos)) > (unsigned int)currentSpriteSpeed) { \
+            (pos) += currentSpriteSpeed; \
+        } else { \
+            (pos) = (target); \
+        } \
+    } else { \
+        if ((unsigned int)((pos) - (target)) > (unsigned int)currentSpriteSpeed) { \
+            (pos) -= currentSpriteSpeed; \
+        } else { \
+            (pos) = (target); \
+        } \
+    }
+
+// Walk toward the player, following the flow field. (See update_sprite_flow_field)
+void move_sprite_chase() {
+    currentSpriteSpeed = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8);
+    SCALE_SPRITE_SPEED();
+
+    // Which tile is the middle of the sprite on?
+    currentSpriteData = SPRITE_MAP_POSITION(sprX + (NES_SPRITE_WIDTH << SPRITE_POSITION_SHIFT), sprY + (NES_SPRITE_HEIGHT << SPRITE_POSITION_SHIFT));
+    if (currentSpriteData >= MAP_DATA_TILE_LENGTH || !SPRITE_FLOW_IS_CURRENT(currentSpriteData)) {
+        // The search hasn't gotten here yet; wait for it.
+        return;
+    }
+
+    // Where the sprite would be if it was lined up with that tile. (The same spot load_sprites puts sprites on a tile)
+    spriteTileTestX = (unsigned int)(currentSpriteData & 0x0f) << (4 + SPRITE_POSITION_SHIFT);
+    spriteTileTestY = (unsigned int)((currentSpriteData & 0xf0) + (HUD_PIXEL_HEIGHT - 1)) << SPRITE_POSITION_SHIFT;
+
+    // Every tile the flow field points to is open, so we don't need to test for walls, as long as we stay lined up
+    // with the row or column we're walking down. When we need to turn, we finish lining up with the new one first,
+    // so we don't catch the corner of a wall.
+    currentSpriteData = spriteFlowDirection[currentSpriteData];
+    switch (currentSpriteData) {
+        case SPRITE_DIRECTION_LEFT:
+        case SPRITE_DIRECTION_RIGHT:
+            currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = currentSpriteData;
+            if (sprY != spriteTileTestY) {
+                MOVE_SPRITE_TOWARD(sprY, spriteTileTestY);
+            } else if (currentSpriteData == SPRITE_DIRECTION_LEFT) {
+                sprX -= currentSpriteSpeed;
+            } else {
+                sprX += currentSpriteSpeed;
+            }
+            break;
+        case SPRITE_DIRECTION_UP:
+        case SPRITE_DIRECTION_DOWN:
+            currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = currentSpriteData;
+            if (sprX != spriteTileTestX) {
+                MOVE_SPRITE_TOWARD(sprX, spriteTileTestX);
+            } else if (currentSpriteData == SPRITE_DIRECTION_UP) {
+                sprY -= currentSpriteSpeed;
+            } else {
+                sprY += currentSpriteSpeed;
+            }
+            break;
+        default:
+            // We're on the player's tile. Stay put; we're touching them already.
+            return;
+    }
+
+    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
+    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
+    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
+    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
+}
+
+// ===== Sprite scripts
+// Sprites with SPRITE_MOVEMENT_SCRIPT follow a little program from spriteScripts. (See sprite_scripts.h) Each command
+// is its own function, called through the spriteScriptCommands table the same way the movement types are. Every
+// command moves scriptPosition on to whatever should run next, and sets scriptStepsLeft to 0 if the sprite's turn is
+// over. sprX8 and sprY8 aren't used until after the sprite moves, so these can share their space.
+#define scriptPosition tempChar7
+#define scriptStepsLeft tempChar8
+
+// The arguments after the current command. (1 is the first one)
+#define SCRIPT_ARGUMENT(n) spriteScripts[scriptPosition + (n)]
+// The sprite's direction, and how many more turns the current WALK or WAIT has to go. (0 if one hasn't started yet)
+#define SCRIPT_DIRECTION currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION]
+#define SCRIPT_TIME_LEFT currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME]
+
+// How far the player is from the sprite, in pixels, as a signed number on each axis. Goes in spriteTileTestX and
+// spriteTileTestY, since nothing is testing the map at the same time.
+#define SCRIPT_FIND_PLAYER() \
+    spriteTileTestX = (int)(playerXPosition >> PLAYER_POSITION_SHIFT) - (int)((unsigned int)sprX >> SPRITE_POSITION_SHIFT); \
+    spriteTileTestY = (int)(playerYPosition >> PLAYER_POSITION_SHIFT) - (int)((unsigned int)sprY >> SPRITE_POSITION_SHIFT);
+
+// The 4 directions, for FACE_RANDOM.
+const unsigned char spriteScriptRandomDirections[4] = {
+    SPRITE_DIRECTION_DOWN, SPRITE_DIRECTION_UP, SPRITE_DIRECTION_RIGHT, SPRITE_DIRECTION_LEFT
+};
+
+// Would taking one step forward put the sprite in a wall, or off the edge of the screen? 0: no, 1: yes
+unsigned char script_wall_ahead() {
+    switch (SCRIPT_DIRECTION) {
+        case SPRITE_DIRECTION_LEFT:
+            if ((unsigned int)sprX < (SCREEN_EDGE_LEFT << SPRITE_POSITION_SHIFT) + currentSpriteSpeed) {
+                return 1;
+            }
+            spriteTileTestX = sprX - currentSpriteSpeed + SPRITE_TILE_HITBOX_LEFT_EDGE;
+            return SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_TOP_EDGE) || SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_BOTTOM_EDGE);
+        case SPRITE_DIRECTION_RIGHT:
+            if ((unsigned int)sprX > (SCREEN_EDGE_RIGHT << SPRITE_POSITION_SHIFT) - SPRITE_TILE_HITBOX_RIGHT_EDGE - currentSpriteSpeed) {
+                return 1;
+            }
+            spriteTileTestX = sprX + currentSpriteSpeed + SPRITE_TILE_HITBOX_RIGHT_EDGE;
+            return SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_TOP_EDGE) || SPRITE_MAP_SOLID(spriteTileTestX, sprY + SPRITE_TILE_HITBOX_BOTTOM_EDGE);
+        case SPRITE_DIRECTION_UP:
+            if ((unsigned int)sprY < ((SCREEN_EDGE_TOP) << SPRITE_POSITION_SHIFT) + currentSpriteSpeed) {
+                return 1;
+            }
+            spriteTileTestY = sprY - currentSpriteSpeed + SPRITE_TILE_HITBOX_TOP_EDGE;
+            return SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_LEFT_EDGE, spriteTileTestY) || SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_RIGHT_EDGE, spriteTileTestY);
+        case SPRITE_DIRECTION_DOWN:
+            if ((unsigned int)sprY > (SCREEN_EDGE_BOTTOM << SPRITE_POSITION_SHIFT) - SPRITE_TILE_HITBOX_BOTTOM_EDGE - currentSpriteSpeed) {
+                return 1;
+            }
+            spriteTileTestY = sprY + currentSpriteSpeed + SPRITE_TILE_HITBOX_BOTTOM_EDGE;
+            return SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_LEFT_EDGE, spriteTileTestY) || SPRITE_MAP_SOLID(sprX + SPRITE_TILE_HITBOX_RIGHT_EDGE, spriteTileTestY);
+    }
+    return 0;
+}
+
+void script_walk() {
+    if (SCRIPT_TIME_LEFT == 0) {
+        SCRIPT_TIME_LEFT = SCRIPT_ARGUMENT(1);
+    }
+    if (script_wall_ahead()) {
+        // Something's in the way, so this walk is over.
+        SCRIPT_TIME_LEFT = 0;
+    } else {
+        switch (SCRIPT_DIRECTION) {
+            case SPRITE_DIRECTION_LEFT:
+                sprX -= currentSpriteSpeed;
                 break;
-            case SPRITE_ANIMATION_NONE:
-            default: 
+            case SPRITE_DIRECTION_RIGHT:
+                sprX += currentSpriteSpeed;
                 break;
+            case SPRITE_DIRECTION_UP:
+                sprY -= currentSpriteSpeed;
+                break;
+            case SPRITE_DIRECTION_DOWN:
+                sprY += currentSpriteSpeed;
+                break;
+        }
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
+        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
+        --SCRIPT_TIME_LEFT;
+    }
+    if (SCRIPT_TIME_LEFT == 0) {
+        scriptPosition += 2;
+    }
+    scriptStepsLeft = 0;
+}
+
+void script_wait() {
+    if (SCRIPT_TIME_LEFT == 0) {
+        SCRIPT_TIME_LEFT = SCRIPT_ARGUMENT(1);
+    }
+    --SCRIPT_TIME_LEFT;
+    if (SCRIPT_TIME_LEFT == 0) {
+        scriptPosition += 2;
+    }
+    scriptStepsLeft = 0;
+}
+
+void script_face() {
+    SCRIPT_DIRECTION = SCRIPT_ARGUMENT(1);
+    scriptPosition += 2;
+}
 
+void script_face_player() {
+    SCRIPT_FIND_PLAYER();
+    // Face along whichever axis the player is further away on.
+    if (spriteTileTestX < 0) {
+        spriteTileTestX = 0 - spriteTileTestX;
+        currentSpriteData = SPRITE_DIRECTION_LEFT;
+    } else {
+        currentSpriteData = SPRITE_DIRECTION_RIGHT;
+    }
+    if (spriteTileTestY < 0) {
+        if (0 - spriteTileTestY > spriteTileTestX) {
+            currentSpriteData = SPRITE_DIRECTION_UP;
         }
-        // We only want to do movement once every other frame, to save some cpu time. 
-        // So, split this to update even sprites on even frames, odd sprites on odd frames
-        if ((i & 0x01) == everyOtherCycle) {
+    } else if (spriteTileTestY > spriteTileTestX) {
+        currentSpriteData = SPRITE_DIRECTION_DOWN;
+    }
+    SCRIPT_DIRECTION = currentSpriteData;
+    ++scriptPosition;
+}
 
-            switch (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE]) {
-                case SPRITE_MOVEMENT_LEFT_RIGHT:
-                    // Get the speed to travel at
-                    currentSpriteData = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SLIDE_SPEED];
+void script_face_random() {
+    SCRIPT_DIRECTION = spriteScriptRandomDirections[rand8() & 0x03];
+    ++scriptPosition;
+}
 
-                    // If it's positive, add to X to get the right of the sprite
-                    if ((signed char) currentSpriteData > 0) {
-                        sprX += currentSpriteFullTileCollisionWidth;
-                    }
-                    // Add speed in
-                    sprX += (signed char)currentSpriteData;
-                    if (test_collision(currentMap[SPRITE_MAP_POSITION(sprX, sprY + SPRITE_TILE_HITBOX_OFFSET)], 0) || test_collision(currentMap[SPRITE_MAP_POSITION(sprX, sprY + currentSpriteFullTileCollisionHeight)], 0)) {
-                        // Never mind... leave X position alone for now
-                        sprX -= (signed char)currentSpriteData;
-                        // Roll back our change to pick right of the sprite
-                        if ((signed char) currentSpriteData > 0) {
-                            sprX -= currentSpriteFullTileCollisionWidth;
-                        }
+void script_turn_around() {
+    // Left and right are 1 bit apart, and so are up and down - it's the same bit for both, so one xor flips either.
+    if (SCRIPT_DIRECTION != SPRITE_DIRECTION_STATIONARY) {
+        SCRIPT_DIRECTION ^= (SPRITE_DIRECTION_LEFT ^ SPRITE_DIRECTION_RIGHT);
+    }
+    ++scriptPosition;
+}
 
-                        // And... flip the direction!
-                        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SLIDE_SPEED] = 0 - (signed char)currentSpriteData;
-                    } else {
-                        // No collision! Roll back our change to pick right of the sprite
-                        if ((signed char) currentSpriteData > 0) {
-                            sprX -= currentSpriteFullTileCollisionWidth;
-                        }
+void script_goto() {
+    scriptPosition = SCRIPT_ARGUMENT(1);
+}
 
+void script_if_wall() {
+    if (script_wall_ahead()) {
+        scriptPosition = SCRIPT_ARGUMENT(1);
+    } else {
+        scriptPosition += 2;
+    }
+}
 
-                        // And move the sprite over!
-                        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
-                        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
-                    }
+void script_if_near() {
+    SCRIPT_FIND_PLAYER();
+    // Same trick as RANGES_OVERLAP: one unsigned comparison for each axis tests both sides at once.
+    currentSpriteData = SCRIPT_ARGUMENT(1);
+    if (
+        (unsigned int)(spriteTileTestX + currentSpriteData - 1) < (unsigned int)((currentSpriteData << 1) - 1) &&
+        (unsigned int)(spriteTileTestY + currentSpriteData - 1) < (unsigned int)((currentSpriteData << 1) - 1)
+    ) {
+        scriptPosition = SCRIPT_ARGUMENT(2);
+    } else {
+        scriptPosition += 3;
+    }
+}
 
-                    break;
-                case SPRITE_MOVEMENT_UP_DOWN:
-                    // Get the speed to travel at
-                    currentSpriteData = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SLIDE_SPEED];
+void script_spawn() {
+    spawnSpriteDefinitionId = SCRIPT_ARGUMENT(1);
+    spawnSpriteX = sprX >> SPRITE_POSITION_SHIFT;
+    spawnSpriteY = sprY >> SPRITE_POSITION_SHIFT;
+    spawn_map_sprite();
+    // If there was no room for it, carry on anyway; the script shouldn't get stuck on a full room.
+    if (spawnedSpriteId != NO_SPRITE_SLOT) {
+        currentMapSpriteData[(spawnedSpriteId << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SCRIPT_DIRECTION;
+    }
+    scriptPosition += 2;
+}
 
-                    // If it's positive, add to X to get the right of the sprite
-                    if ((signed char) currentSpriteData > 0) {
-                        sprY += currentSpriteFullTileCollisionWidth;
-                    }
-                    // Add speed in
-                    sprY += (signed char)currentSpriteData;
-                    if (test_collision(currentMap[SPRITE_MAP_POSITION(sprX + SPRITE_TILE_HITBOX_OFFSET, sprY)], 0) || test_collision(currentMap[SPRITE_MAP_POSITION(sprX + currentSpriteFullTileCollisionWidth, sprY)], 0)) {
-                        // Never mind... leave X position alone for now
-                        sprY -= (signed char)currentSpriteData;
-                        // Roll back our change to pick right of the sprite
-                        if ((signed char) currentSpriteData > 0) {
-                            sprY -= currentSpriteFullTileCollisionWidth;
-                        }
+void script_remove() {
+    // update_map_sprites hides it next frame. The script stays on this command, in case anything brings it back.
+    DESPAWN_MAP_SPRITE(i);
+    scriptStepsLeft = 0;
+}
 
-                        // And... flip the direction!
-                        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SLIDE_SPEED] = 0 - (signed char)currentSpriteData;
-                    } else {
-                        // No collision! Roll back our change to pick right of the sprite
-                        if ((signed char) currentSpriteData > 0) {
-                            sprY -= currentSpriteFullTileCollisionWidth;
-                        }
+// The script commands, in the same order as the SPRITE_SCRIPT_OP_ ids in sprite_scripts.h.
+void (* const spriteScriptCommands[SPRITE_SCRIPT_OP_COUNT])(void) = {
+    script_walk,
+    script_wait,
+    script_face,
+    script_face_player,
+    script_face_random,
+    script_turn_around,
+    script_goto,
+    script_if_wall,
+    script_if_near,
+    script_spawn,
+    script_remove
+};
 
+// Run the sprite's script until it uses up its turn.
+void move_sprite_script() {
+    currentSpriteSpeed = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8);
+    SCALE_SPRITE_SPEED();
 
-                        // And move the sprite over!
-                        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
-                        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
-                    }
+    scriptPosition = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SCRIPT_POSITION];
+    scriptStepsLeft = SPRITE_SCRIPT_MAX_STEPS;
+    while (scriptStepsLeft != 0) {
+        --scriptStepsLeft;
+        spriteScriptCommands[spriteScripts[scriptPosition]]();
+    }
+    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SCRIPT_POSITION] = scriptPosition;
+}
 
-                    break;
-                case SPRITE_MOVEMENT_RANDOM_WANDER:
-                    // Okay, we're going to simulate an intelligent enemy. 
-                    
-                    // First, how long have we been travelling in the same direction? Is it time for a swap?
-                    if (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME] == 0) {
-                        // Yep. Figure out if direction is: none, left, right, up, or down we do this by getting a random number
-                        // between 0 and 8 with bit masking. If it's 0, stop for a bit... if it's 1, left... 4 down, or 5-7, maintain.
-                        switch (rand8() & 0x07) {
-                            case 0:
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_STATIONARY;
-                                break;
-                            case 1:
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_LEFT;
-                                break;
-                            case 2:
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_RIGHT;
-                                break;
-                            case 3: 
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_UP;
-                                break;
-                            case 4:
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_DOWN;
-                                break;
-                            default:
-                                // Do nothing - just carry on in the direction you're going for another cycle.
-                                break;
-                        }
-                        currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME] = 20 + (rand8() & 31);
-                    } else {
-                        --currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DIRECTION_TIME];
-                    }
+// The animation and movement functions, in the same order as the SPRITE_ANIMATION_ and SPRITE_MOVEMENT_ ids in
+// sprite_definitions.h. Calling a function from a table like this takes the same amount of time no matter how many
+// types there are, unlike a switch statement, which has to check each one in turn. To add a new type, write a
+// function for it, add it to the end of the table, and give it the next id.
+void (* const spriteAnimationHandlers[SPRITE_ANIMATION_COUNT])(void) = {
+    sprite_behavior_none,
+    animate_sprite_sequence,
+    animate_sprite_sequence,
+    animate_sprite_full
+};
+void (* const spriteMovementHandlers[SPRITE_MOVEMENT_COUNT])(void) = {
+    sprite_behavior_none,
+    move_sprite_left_right,
+    move_sprite_up_down,
+    move_sprite_random_wander,
+    move_sprite_chase,
+    move_sprite_script
+};
+
+// Roughly how long each movement function above takes, in units of about 100 cpu cycles, in the same order. The
+// scheduler uses these to decide how to spread sprites out. (See SPRITE_AI_FRAME_BUDGET in map_sprites.h) Sprites that
+// don't move cost nothing, and never get a turn.
+const unsigned char spriteMovementCosts[SPRITE_MOVEMENT_COUNT] = {
+    0,
+    10,
+    10,
+    16,
+    12,
+    20
+};
+
+// Temporary variables for schedule_map_sprites. It only runs at the start of update_map_sprites, so it can share them.
+#define scheduleCost tempChar2
+#define schedulePhase tempChar3
+#define scheduleBestPhase tempChar4
+
+void schedule_map_sprites() {
+    spriteScheduleDirty = 0;
+
+    // First, add up how much work all of the moving sprites are. While we're at it, see if anything needs the flow
+    // field.
+    spriteScheduleTotalCost = 0;
+    spriteFlowActive = 0;
+    for (i = 0; i != MAP_SPRITE_SLOT_COUNT; ++i) {
+        if (currentMapSpriteData[(i << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_TYPE] != SPRITE_TYPE_OFFSCREEN) {
+            spriteScheduleTotalCost += spriteMovementCosts[currentMapSpriteData[(i << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE]];
+            if (currentMapSpriteData[(i << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE] == SPRITE_MOVEMENT_CHASE) {
+                spriteFlowActive = 1;
+            }
+        }
+    }
 
-                    // Set currentSpriteData to the sprite speed for now (NOTE: we overwrite this after the switch statement) 
-                    // We'll then add/subtract it from sprX and sprY
-                    currentSpriteData = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_MOVE_SPEED];
-                    switch (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION]) {
-                        case SPRITE_DIRECTION_LEFT:
-
-                            sprX -= currentSpriteData;
-                            if (sprX < SCREEN_EDGE_LEFT << SPRITE_POSITION_SHIFT) {
-                                // Roll back the position since we use sprX to place the sprite
-                                sprX += currentSpriteData;
-                                break;
-                            }
-                            
-                            // If we have not collided, save the new position. Else, just exit.
-                            if (!test_collision(currentMap[SPRITE_MAP_POSITION(sprX, sprY + SPRITE_TILE_HITBOX_OFFSET)], 0) && !test_collision(currentMap[SPRITE_MAP_POSITION(sprX, sprY + currentSpriteFullTileCollisionHeight)], 0)) {
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
-                            } else {
-                                // Roll back the position since we use sprX to place the sprite
-                                sprX -= currentSpriteData;
-                            }
-
-                            break;
-                        case SPRITE_DIRECTION_RIGHT:
-                            // Set the X position to our new position, plus the full width of the sprite for the collision test
-                            sprX += currentSpriteData + currentSpriteFullTileCollisionWidth;
-                            if (sprX > SCREEN_EDGE_RIGHT << SPRITE_POSITION_SHIFT) {
-                                // Roll back the position since we use sprX to place the sprite
-                                sprX -= currentSpriteData + currentSpriteFullTileCollisionWidth;
-                                break;
-                            }
+    // Use the shortest cycle that fits it all in the budget. (Or the longest one we have, if nothing fits)
+    spriteScheduleShift = 0;
+    while (spriteScheduleShift != SPRITE_AI_MAX_SCHEDULE_SHIFT && spriteScheduleTotalCost > (SPRITE_AI_FRAME_BUDGET << spriteScheduleShift)) {
+        ++spriteScheduleShift;
+    }
+
+    // Now hand out turns. Each sprite goes on whichever frame of the cycle has the least work on it so far.
+    for (schedulePhase = 0; schedulePhase != (1 << SPRITE_AI_MAX_SCHEDULE_SHIFT); ++schedulePhase) {
+        spriteSchedulePhaseCost[schedulePhase] = 0;
+    }
+    for (i = 0; i != MAP_SPRITE_SLOT_COUNT; ++i) {
+        scheduleCost = spriteMovementCosts[currentMapSpriteData[(i << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE]];
+        if (scheduleCost == 0 || currentMapSpriteData[(i << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_TYPE] == SPRITE_TYPE_OFFSCREEN) {
+            spriteSchedulePhase[i] = SPRITE_NOT_SCHEDULED;
+            continue;
+        }
+        scheduleBestPhase = 0;
+        for (schedulePhase = 1; schedulePhase != (1 << spriteScheduleShift); ++schedulePhase) {
+            if (spriteSchedulePhaseCost[schedulePhase] < spriteSchedulePhaseCost[scheduleBestPhase]) {
+                scheduleBestPhase = schedulePhase;
+            }
+        }
+        spriteSchedulePhase[i] = scheduleBestPhase;
+        spriteSchedulePhaseCost[scheduleBestPhase] += scheduleCost;
+    }
+}
+
+// schedule_new_map_sprite is called from init_map_sprite, so it has its own variables like that does.
+unsigned char newScheduleCost;
+unsigned char newSchedulePhase;
+unsigned char newScheduleBestPhase;
+
+void schedule_new_map_sprite() {
+    newScheduleCost = spriteMovementCosts[spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE]];
+    if (newScheduleCost == 0) {
+        spriteSchedulePhase[spawnedSpriteId] = SPRITE_NOT_SCHEDULED;
+        return;
+    }
+    if (spriteDefinitions[spawnSpriteDefinitionIndex + SPRITE_DEF_POSITION_MOVEMENT_TYPE] == SPRITE_MOVEMENT_CHASE) {
+        spriteFlowActive = 1;
+    }
+
+    // Put it on whichever frame of the current cycle has the least work, and leave everyone else where they are. (If
+    // that frame has already gone by this cycle, the sprite just waits for the next one.)
+    newScheduleBestPhase = 0;
+    for (newSchedulePhase = 1; newSchedulePhase != (1 << spriteScheduleShift); ++newSchedulePhase) {
+        if (spriteSchedulePhaseCost[newSchedulePhase] < spriteSchedulePhaseCost[newScheduleBestPhase]) {
+            newScheduleBestPhase = newSchedulePhase;
+        }
+    }
+    spriteSchedulePhase[spawnedSpriteId] = newScheduleBestPhase;
+    spriteSchedulePhaseCost[newScheduleBestPhase] += newScheduleCost;
+    spriteScheduleTotalCost += newScheduleCost;
+
+    // If that pushed us over budget, ask for a longer cycle. That waits for the end of this one, in update_map_sprites.
+    if (spriteScheduleShift != SPRITE_AI_MAX_SCHEDULE_SHIFT && spriteScheduleTotalCost > (SPRITE_AI_FRAME_BUDGET << spriteScheduleShift)) {
+        spriteScheduleDirty = 1;
+    }
+}
+
+void reset_sprite_flow_field() {
+    memfill(spriteFlowSearchId, 0, MAP_DATA_TILE_LENGTH);
+    // Tiles set by a search more than 1 before the current one don't count, so starting at 2 makes every tile stale.
+    spriteFlowCurrentSearchId = 2;
+    spriteFlowTargetTile = SPRITE_FLOW_NO_TILE;
+    spriteFlowQueueStart = 0;
+    spriteFlowQueueEnd = 0;
+}
+
+// Temporary variables for update_sprite_flow_field. Like the scheduler, it runs before update_map_sprites uses its own.
+#define flowTile tempChar2
+#define flowNextTile tempChar3
+#define flowTilesLeft tempChar4
+
+// Add flowNextTile to the search, if it's open and this search hasn't been there yet. Sprites on it should step in
+// `direction` to get to flowTile.
+#define VISIT_FLOW_TILE(direction) \
+    if (spriteFlowSearchId[flowNextTile] != spriteFlowCurrentSearchId && !MAP_INDEX_IS_SOLID(flowNextTile)) { \
+        spriteFlowSearchId[flowNextTile] = spriteFlowCurrentSearchId; \
+        spriteFlowDirection[flowNextTile] = (direction); \
+        spriteFlowQueue[spriteFlowQueueEnd] = flowNextTile; \
+        ++spriteFlowQueueEnd; \
+    }
+
+void update_sprite_flow_field() {
+    // Which tile is the middle of the player on? If it's a new one, start a new search from there. (If it's a wall, or
+    // off the edge of the room, like during a screen transition, just keep going with the one we have.)
+    flowTile = PLAYER_MAP_POSITION(playerXPosition + (NES_SPRITE_WIDTH << PLAYER_POSITION_SHIFT), playerYPosition + (NES_SPRITE_HEIGHT << PLAYER_POSITION_SHIFT));
+    if (flowTile != spriteFlowTargetTile && flowTile < MAP_DATA_TILE_LENGTH && !MAP_INDEX_IS_SOLID(flowTile)) {
+        spriteFlowTargetTile = flowTile;
+        ++spriteFlowCurrentSearchId;
+        if (spriteFlowCurrentSearchId == 0) {
+            // We've used every id, so clear out the old ones before they come around again. Sprites have to wait for
+            // the new search to reach them this one time.
+            memfill(spriteFlowSearchId, 0, MAP_DATA_TILE_LENGTH);
+            spriteFlowCurrentSearchId = 2;
+        }
+        spriteFlowSearchId[flowTile] = spriteFlowCurrentSearchId;
+        spriteFlowDirection[flowTile] = SPRITE_DIRECTION_STATIONARY;
+        spriteFlowQueue[0] = flowTile;
+        spriteFlowQueueStart = 0;
+        spriteFlowQueueEnd = 1;
+    }
+
+    // Carry on with the search. Tiles come off the queue in the order they were reached, so tiles closer to the player
+    // always go first, and the first way the search finds to a tile is the shortest one.
+    for (flowTilesLeft = SPRITE_FLOW_TILES_PER_FRAME; flowTilesLeft != 0 && spriteFlowQueueStart != spriteFlowQueueEnd; --flowTilesLeft) {
+        flowTile = spriteFlowQueue[spriteFlowQueueStart];
+        ++spriteFlowQueueStart;
+
+        // Look at the 4 tiles around this one, without wrapping around the edges of the room.
+        if ((flowTile & 0x0f) != 0) {
+            flowNextTile = flowTile - 1;
+            VISIT_FLOW_TILE(SPRITE_DIRECTION_RIGHT);
+        }
+        if ((flowTile & 0x0f) != 0x0f) {
+            flowNextTile = flowTile + 1;
+            VISIT_FLOW_TILE(SPRITE_DIRECTION_LEFT);
+        }
+        if (flowTile >= 16) {
+            flowNextTile = flowTile - 16;
+            VISIT_FLOW_TILE(SPRITE_DIRECTION_DOWN);
+        }
+        if (flowTile < MAP_DATA_TILE_LENGTH - 16) {
+            flowNextTile = flowTile + 16;
+            VISIT_FLOW_TILE(SPRITE_DIRECTION_UP);
+        }
+    }
+}
+
+void update_map_sprites() {
+    // Moving sprites is spread out over a few frames; see schedule_map_sprites. If the schedule needs working out again,
+    // we wait until a new cycle starts to do it. Doing it in the middle of a cycle would skip the frames after this one,
+    // and in a room where things spawn often, the sprites on those frames might never get to move.
+    ++spriteScheduleFrame;
+    if (spriteScheduleFrame == (1 << spriteScheduleShift)) {
+        spriteScheduleFrame = 0;
+        ++spriteScheduleCycle;
+        if (spriteScheduleDirty) {
+            schedule_map_sprites();
+        }
+    }
+
+    // Keep the flow field for chasing sprites up to date.
+    if (spriteFlowActive) {
+        update_sprite_flow_field();
+    }
+
+    // The flicker order below changes every other frame. When it does, every sprite lands in a different spot in OAM,
+    // so sleeping sprites and empty slots have to be written out again too.
+    if ((frameCount & 0x02) != spriteOamFlicker) {
+        spriteOamFlicker ^= 0x02;
+        spriteOamFlickerChanged = 1;
+    } else {
+        spriteOamFlickerChanged = 0;
+    }
+
+    for (i = 0; i < MAP_SPRITE_SLOT_COUNT; ++i) {
+        currentMapSpriteIndex = i << MAP_SPRITE_DATA_SHIFT;
         
-                            // If we have not collided, save the new position. Else, just exit.
-                            if (!test_collision(currentMap[SPRITE_MAP_POSITION(sprX, sprY + SPRITE_TILE_HITBOX_OFFSET)], 0) && !test_collision(currentMap[SPRITE_MAP_POSITION(sprX, sprY + currentSpriteFullTileCollisionHeight)], 0)) {
-                                // If we did collide, we added the full width of the sprite to sprX; take that back out.
-                                sprX -= currentSpriteFullTileCollisionWidth;
-
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X] = (sprX & 0xff);
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X+1] = (sprX >> 8);
-                            } else {
-                                // Roll back the position since we use sprX to place the sprite
-                                sprX -= currentSpriteData + currentSpriteFullTileCollisionWidth;
-                            }
-                            break;
-                        case SPRITE_DIRECTION_UP:
-                            sprY -= currentSpriteData;
-                            if (sprY < SCREEN_EDGE_TOP << SPRITE_POSITION_SHIFT) {
-                                // Roll back the position since we use sprY to place the sprite
-                                sprY += currentSpriteData;
-                                break;
-                            }
-
-                            // If we have not collided, save the new position. Else, just exit.
-                            if (!test_collision(currentMap[SPRITE_MAP_POSITION(sprX + SPRITE_TILE_HITBOX_OFFSET, sprY)], 0) && !test_collision(currentMap[SPRITE_MAP_POSITION(sprX + currentSpriteFullTileCollisionWidth, sprY)], 0)) {
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
-                            } else {
-                                // Roll back the position since we use sprY to place the sprite
-                                sprY += currentSpriteData;
-                            }
-
-                            break;
-                        case SPRITE_DIRECTION_DOWN:
-                            // Set our Y position to the new position, plus the full height of the sprite for collisions
-                            sprY += currentSpriteData + currentSpriteFullTileCollisionHeight;
-
-                            if (sprY > SCREEN_EDGE_BOTTOM << SPRITE_POSITION_SHIFT) {
-                                // Roll back the position since we use sprY to place the sprite
-                                sprY -= currentSpriteData + currentSpriteFullTileCollisionHeight;
-                                break;
-                            }
-
-                            // If we have not collided, save the new position. Else, just exit.
-                            if (!test_collision(currentMap[SPRITE_MAP_POSITION(sprX + SPRITE_TILE_HITBOX_OFFSET, sprY)], 0) && !test_collision(currentMap[SPRITE_MAP_POSITION(sprX + currentSpriteFullTileCollisionWidth, sprY)], 0)) {
-                                // Reset sprY to the top of the sprite before we update.
-                                sprY -= currentSpriteFullTileCollisionHeight;
-
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y] = (sprY & 0xff);
-                                currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y+1] = (sprY >> 8);
-                            } else {
-                                // Roll back the position since we use sprY to place the sprite
-                                sprY -= currentSpriteData + currentSpriteFullTileCollisionHeight;
-                            }
-
-                            break;
-                    }
+        // This switches what position we write the sprite to regularly, so we can maintain a flicker effect instead
+        // of having the sprite just randomly disappear. We use 0x02 so it flips every other frame, so flickering is less
+        // likely to fail if we lose a frame. (If you have enough sprites to flicker, you may also see slowdown.)
+        if (spriteOamFlicker) {
+            oamMapSpriteIndex = (MAP_SPRITE_SLOT_COUNT-i-1) << MAP_SPRITE_OAM_SHIFT;
+        } else {
+            oamMapSpriteIndex = i << MAP_SPRITE_OAM_SHIFT;
+        }
+        oamMapSpriteIndex += FIRST_ENEMY_SPRITE_OAM_INDEX;
 
-                    break;
+        if (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_TYPE] == SPRITE_TYPE_OFFSCREEN) {
+            // Hide it and move on. Only the y position matters for hiding a sprite, and nothing else writes to this
+            // spot in OAM, so we only need to do this once each time it moves.
+            if (spriteOamState[i] != SPRITE_OAM_HIDDEN || spriteOamFlickerChanged) {
+                oamBuffer[oamMapSpriteIndex] = SPRITE_OFFSCREEN;
+                oamBuffer[oamMapSpriteIndex + 4] = SPRITE_OFFSCREEN;
+                oamBuffer[oamMapSpriteIndex + 8] = SPRITE_OFFSCREEN;
+                oamBuffer[oamMapSpriteIndex + 12] = SPRITE_OFFSCREEN;
+                spriteOamState[i] = SPRITE_OAM_HIDDEN;
+                spriteCollisionWidth[i] = 0;
+            }
 
+            // If the sprite still has a turn to move, it just went away; take its work off the schedule. If everything
+            // left fits in a shorter cycle, ask for one. (Like a longer one, that waits for the end of this cycle.)
+            if (spriteSchedulePhase[i] != SPRITE_NOT_SCHEDULED) {
+                currentSpriteData = spriteMovementCosts[currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE]];
+                spriteSchedulePhaseCost[spriteSchedulePhase[i]] -= currentSpriteData;
+                spriteScheduleTotalCost -= currentSpriteData;
+                spriteSchedulePhase[i] = SPRITE_NOT_SCHEDULED;
+                if (spriteScheduleShift != 0 && spriteScheduleTotalCost <= (SPRITE_AI_FRAME_BUDGET << (spriteScheduleShift - 1))) {
+                    spriteScheduleDirty = 1;
+                }
+            }
 
-                case SPRITE_MOVEMENT_NONE:
-                default:
-                    break;
+            // If this is a spawn slot, and it's not on the free list yet, put it back so it can be used again.
+            if (i >= MAP_MAX_SPRITES && !(spawnedSpriteFreeMask & bitToByte[i - MAP_MAX_SPRITES])) {
+                spawnedSpriteFreeMask |= bitToByte[i - MAP_MAX_SPRITES];
+                spawnedSpriteFreeList[spawnedSpriteFreeCount] = i;
+                ++spawnedSpriteFreeCount;
+            }
+            continue;
+        }
+
+        // Sleeping sprites look the same as last time; at most, they need to be copied to their new spot in OAM.
+        // Their place in the sprite grid and their hitbox haven't changed either.
+        if (spriteOamState[i] == SPRITE_OAM_ASLEEP) {
+            if (spriteOamFlickerChanged) {
+                memcpy(&oamBuffer[oamMapSpriteIndex], &spriteOamCache[i << MAP_SPRITE_OAM_SHIFT], (1 << MAP_SPRITE_OAM_SHIFT));
+            }
+            continue;
+        }
+
+        sprX = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X + 1]) << 8));
+        sprY = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y + 1]) << 8));
+        currentSpriteSize = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_SIZE_MASK; 
+        currentSpriteTileId = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_TILE_ID];
+        currentSpriteAttributes = (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_PALETTE_MASK) >> 6;
+
+        // Pick the tile to show for this frame. (See spriteAnimationHandlers above)
+        spriteAnimationHandlers[currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_ANIMATION_TYPE]]();
+
+        // Only move the sprite if it's its turn. (See schedule_map_sprites)
+        if (spriteSchedulePhase[i] == spriteScheduleFrame) {
+            currentSpriteMoveShift = spriteScheduleShift;
+            #if SPRITE_AI_FAR_SLOWDOWN
+                // Sprites far from the player only move every other turn, twice as far. Odd and even sprites take turns,
+                // so they don't all move on the same cycle.
+                if (spriteScheduleShift != SPRITE_AI_MAX_SCHEDULE_SHIFT && !(spriteNearPlayerMask & spriteGridBit[i])) {
+                    ++currentSpriteMoveShift;
+                }
+            #endif
+            if (currentSpriteMoveShift == spriteScheduleShift || ((spriteScheduleCycle ^ i) & 0x01)) {
+                spriteMovementHandlers[currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE]]();
             }
         }
         
@@ -323,66 +1021,304 @@ void update_map_sprites() {
                 sprX8 + (NES_SPRITE_WIDTH/2),
                 sprY8 + (NES_SPRITE_HEIGHT/2),
                 currentSpriteTileId,
-                (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_PALETTE_MASK) >> 6,
+                currentSpriteAttributes,
                 oamMapSpriteIndex
             );
+            // Hide the other 3 entries in this sprite's spot, so nothing left over from another sprite shows up.
+            oamBuffer[oamMapSpriteIndex + 4] = SPRITE_OFFSCREEN;
+            oamBuffer[oamMapSpriteIndex + 8] = SPRITE_OFFSCREEN;
+            oamBuffer[oamMapSpriteIndex + 12] = SPRITE_OFFSCREEN;
         } else if (currentSpriteSize == SPRITE_SIZE_16PX_16PX) {
+            // A mirrored sprite has to swap its left and right columns of tiles too, or each half would be flipped in
+            // place. This is 1 if it does, 0 if not.
+            currentSpriteFlipColumn = (currentSpriteAttributes & OAM_FLIP_H) ? 1 : 0;
             oam_spr(
                 sprX8,
                 sprY8,
-                currentSpriteTileId,
-                (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_PALETTE_MASK) >> 6,
+                currentSpriteTileId + currentSpriteFlipColumn,
+                currentSpriteAttributes,
                 oamMapSpriteIndex
             );
             oam_spr(
                 sprX8 + NES_SPRITE_WIDTH,
                 sprY8,
-                currentSpriteTileId + 1,
-                (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_PALETTE_MASK) >> 6,
+                currentSpriteTileId + 1 - currentSpriteFlipColumn,
+                currentSpriteAttributes,
                 oamMapSpriteIndex + 4
             );
             oam_spr(
                 sprX8,
                 sprY8 + NES_SPRITE_HEIGHT,
-                currentSpriteTileId + 16,
-                (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_PALETTE_MASK) >> 6,
+                currentSpriteTileId + 16 + currentSpriteFlipColumn,
+                currentSpriteAttributes,
                 oamMapSpriteIndex + 8
             );
             oam_spr(
                 sprX8 + NES_SPRITE_WIDTH,
                 sprY8 + NES_SPRITE_HEIGHT,
-                currentSpriteTileId + 17,
-                (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SIZE_PALETTE] & SPRITE_PALETTE_MASK) >> 6,
+                currentSpriteTileId + 17 - currentSpriteFlipColumn,
+                currentSpriteAttributes,
                 oamMapSpriteIndex + 12
             );
 
 
         }
 
-        // While we have all the data above, let's see if the player hit us.
-        
-        // Only test collision for sprite types that collide.
-        currentSpriteType = currentMapSpriteData[(currentMapSpriteIndex) + MAP_SPRITE_DATA_POS_TYPE];
-        if (currentSpriteType != SPRITE_TYPE_NOTHING && currentSpriteType != SPRITE_TYPE_OFFSCREEN) {
-
-            // For 16x16 enemy sprites, make their hitbox a bit smaller
-            if (currentSpriteType == SPRITE_TYPE_REGULAR_ENEMY) {
-                sprX -= SPRITE_HITBOX_OFFSET;
-                sprY -= SPRITE_HITBOX_OFFSET;
+        // Keep the sprite grid up to date. We only touch it if the sprite moved into a different cell, which doesn't
+        // happen often.
+        currentSpriteGridCell = SPRITE_GRID_CELL((unsigned char)(sprX8 + (NES_SPRITE_WIDTH)), (unsigned char)(sprY8 + (NES_SPRITE_HEIGHT)));
+        if (currentSpriteGridCell != spriteGridCellForSprite[i]) {
+            if (spriteGridCellForSprite[i] != SPRITE_GRID_NO_CELL) {
+                spriteGridCellMasks[spriteGridCellForSprite[i]] &= ~spriteGridBit[i];
             }
+            spriteGridCellMasks[currentSpriteGridCell] |= spriteGridBit[i];
+            spriteGridCellForSprite[i] = currentSpriteGridCell;
+        }
+
+        // Remember where the sprite's hitbox is for find_sprite_sprite_collisions. Decorations don't bump into anything.
+        spriteCollisionLeft[i] = sprX8 + spriteHitboxLeft[i];
+        spriteCollisionTop[i] = sprY8 + spriteHitboxTop[i];
+        if (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_TYPE] == SPRITE_TYPE_NOTHING) {
+            spriteCollisionWidth[i] = 0;
+        } else {
+            spriteCollisionWidth[i] = spriteHitboxWidth[i];
+        }
+
+        // A sprite that doesn't move or animate will look like this until something changes it, so save its OAM
+        // entries and put it to sleep.
+        if (
+            currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE] == SPRITE_MOVEMENT_NONE &&
+            currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_ANIMATION_TYPE] == SPRITE_ANIMATION_NONE
+        ) {
+            memcpy(&spriteOamCache[i << MAP_SPRITE_OAM_SHIFT], &oamBuffer[oamMapSpriteIndex], (1 << MAP_SPRITE_OAM_SHIFT));
+            spriteOamState[i] = SPRITE_OAM_ASLEEP;
+        }
+    }
+
+    #if SPRITE_SPRITE_COLLISIONS
+        // We only need to test sprites against each other once per schedule cycle. We do it on the last frame of the
+        // cycle, so every sprite has had a chance to move since the last test.
+        if (spriteScheduleFrame == (1 << spriteScheduleShift) - 1) {
+            find_sprite_sprite_collisions();
+        }
+    #endif
+
+    find_player_sprite_collisions();
+}
 
-            // Collision test... see here for a clear explanation: https://developer.mozilla.org/en-US/docs/Games/Techniques/2D_collision_detection
-            // rect1=player position, rect2=sprite position
-            if (
-                playerXPosition < sprX + currentSpriteFullWidth &&
-                playerXPosition + PLAYER_WIDTH_EXTENDED > sprX &&
-                playerYPosition < sprY + currentSpriteFullHeight &&
-                playerYPosition + PLAYER_HEIGHT_EXTENDED > sprY
+#if SPRITE_SPRITE_COLLISIONS
+
+// Temporary variables for find_sprite_sprite_collisions and the functions it calls.
+#define spriteSortIndex tempChar2
+#define spriteSweepIndex tempChar3
+#define spriteCollisionId tempChar4
+#define spriteCollisionPosition tempChar5
+#define spriteCollisionPairCount tempChar7
+#define spriteSortKey tempChar8
+#define spriteCollisionOtherId tempChar9
+#define spriteCollisionOtherPosition tempChara
+
+void find_sprite_sprite_collisions() {
+    // First, sort the sprites by their left edge. We use an insertion sort: it's slow if the list is all mixed up, but
+    // sprites only move a pixel or two at a time, so the list is almost always sorted already. Then it only takes one
+    // comparison per sprite.
+    for (spriteSortIndex = 1; spriteSortIndex != MAP_SPRITE_SLOT_COUNT; ++spriteSortIndex) {
+        spriteCollisionId = spriteSortOrder[spriteSortIndex];
+        spriteSortKey = spriteCollisionLeft[spriteCollisionId];
+        for (spriteSweepIndex = spriteSortIndex; spriteSweepIndex != 0 && spriteCollisionLeft[spriteSortOrder[spriteSweepIndex-1]] > spriteSortKey; --spriteSweepIndex) {
+            spriteSortOrder[spriteSweepIndex] = spriteSortOrder[spriteSweepIndex-1];
+        }
+        spriteSortOrder[spriteSweepIndex] = spriteCollisionId;
+    }
+
+    // Now sweep across the screen from left to right. For each sprite, we only have to look at the sprites after it in
+    // the list, and only until we find one that starts past its right edge - everything after that is further right.
+    // If the last pass ran out of pairs partway through, we start where it left off and wrap back around to the start
+    // of the list, so the pairs it didn't get to go first this time.
+    spriteCollisionPairCount = 0;
+    spriteSortIndex = spriteCollisionSweepStart;
+    do {
+        spriteCollisionId = spriteSortOrder[spriteSortIndex];
+        if (spriteCollisionWidth[spriteCollisionId] != 0) {
+            spriteSortKey = spriteCollisionLeft[spriteCollisionId];
+
+            // (The list is sorted, so the other sprite's left edge is never less than ours, and this can't go negative.)
+            for (
+                spriteSweepIndex = spriteSortIndex + 1;
+                spriteSweepIndex != MAP_SPRITE_SLOT_COUNT && (unsigned char)(spriteCollisionLeft[spriteSortOrder[spriteSweepIndex]] - spriteSortKey) < spriteCollisionWidth[spriteCollisionId];
+                ++spriteSweepIndex
             ) {
-                lastPlayerSpriteCollisionId = i;
+                spriteCollisionOtherId = spriteSortOrder[spriteSweepIndex];
+                if (spriteCollisionWidth[spriteCollisionOtherId] == 0) {
+                    continue;
+                }
+
+                // They overlap left to right; what about top to bottom?
+                if (RANGES_OVERLAP(spriteCollisionTop[spriteCollisionId], spriteHitboxHeight[spriteCollisionId], spriteCollisionTop[spriteCollisionOtherId], spriteHitboxHeight[spriteCollisionOtherId])) {
+                    // Let each sprite react to the other one, then swap the ids back so we can keep going.
+                    handle_sprite_sprite_collision();
+                    spriteCollisionOtherId = spriteCollisionId;
+                    spriteCollisionId = spriteSortOrder[spriteSweepIndex];
+                    handle_sprite_sprite_collision();
+                    spriteCollisionId = spriteCollisionOtherId;
+
+                    ++spriteCollisionPairCount;
+                    if (spriteCollisionPairCount == SPRITE_SPRITE_COLLISION_MAX_PAIRS) {
+                        // That's all we have time for. Next pass picks up with the sprite after this one.
+                        ++spriteSortIndex;
+                        if (spriteSortIndex == MAP_SPRITE_SLOT_COUNT) {
+                            spriteSortIndex = 0;
+                        }
+                        spriteCollisionSweepStart = spriteSortIndex;
+                        return;
+                    }
+                }
             }
         }
 
-        
+        ++spriteSortIndex;
+        if (spriteSortIndex == MAP_SPRITE_SLOT_COUNT) {
+            spriteSortIndex = 0;
+        }
+    } while (spriteSortIndex != spriteCollisionSweepStart);
+}
+
+// Turn spriteCollisionId around, if it's moving toward spriteCollisionOtherId. If it's already moving away, we leave
+// it alone, so two sprites that end up on top of each other can walk back out.
+void turn_sprite_away() {
+    currentMapSpriteIndex = spriteCollisionId << MAP_SPRITE_DATA_SHIFT;
+    currentSpriteData = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_MOVEMENT_TYPE];
+
+    if (currentSpriteData == SPRITE_MOVEMENT_LEFT_RIGHT || currentSpriteData == SPRITE_MOVEMENT_UP_DOWN) {
+        // These sprites store a signed speed; flip it to turn around, like hitting a wall does.
+        if (currentSpriteData == SPRITE_MOVEMENT_LEFT_RIGHT) {
+            spriteCollisionPosition = spriteCollisionLeft[spriteCollisionId];
+            spriteCollisionOtherPosition = spriteCollisionLeft[spriteCollisionOtherId];
+        } else {
+            spriteCollisionPosition = spriteCollisionTop[spriteCollisionId];
+            spriteCollisionOtherPosition = spriteCollisionTop[spriteCollisionOtherId];
+        }
+        currentSpriteSpeed = currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] + (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED + 1] << 8);
+        if (
+            (currentSpriteSpeed > 0 && spriteCollisionOtherPosition > spriteCollisionPosition) ||
+            (currentSpriteSpeed < 0 && spriteCollisionOtherPosition < spriteCollisionPosition)
+        ) {
+            currentSpriteSpeed = 0 - currentSpriteSpeed;
+            currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED] = (currentSpriteSpeed & 0xff);
+            currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_SPEED+1] = (currentSpriteSpeed >> 8);
+        }
+    } else if (currentSpriteData == SPRITE_MOVEMENT_RANDOM_WANDER || currentSpriteData == SPRITE_MOVEMENT_SCRIPT) {
+        // Wandering and scripted sprites just pick the opposite direction.
+        switch (currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION]) {
+            case SPRITE_DIRECTION_LEFT:
+                if (spriteCollisionLeft[spriteCollisionOtherId] < spriteCollisionLeft[spriteCollisionId]) {
+                    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_RIGHT;
+                }
+                break;
+            case SPRITE_DIRECTION_RIGHT:
+                if (spriteCollisionLeft[spriteCollisionOtherId] > spriteCollisionLeft[spriteCollisionId]) {
+                    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_LEFT;
+                }
+                break;
+            case SPRITE_DIRECTION_UP:
+                if (spriteCollisionTop[spriteCollisionOtherId] < spriteCollisionTop[spriteCollisionId]) {
+                    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_DOWN;
+                }
+                break;
+            case SPRITE_DIRECTION_DOWN:
+                if (spriteCollisionTop[spriteCollisionOtherId] > spriteCollisionTop[spriteCollisionId]) {
+                    currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_CURRENT_DIRECTION] = SPRITE_DIRECTION_UP;
+                }
+                break;
+        }
+    }
+}
+
+void handle_sprite_sprite_collision() {
+    switch (currentMapSpriteData[(spriteCollisionId << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_TYPE]) {
+        case SPRITE_TYPE_REGULAR_ENEMY:
+            // Enemies can't walk through each other, or through doors. They walk right over keys and hearts, though.
+            // If you want enemies to push or hurt each other, this is the place to do it!
+            switch (currentMapSpriteData[(spriteCollisionOtherId << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_TYPE]) {
+                case SPRITE_TYPE_REGULAR_ENEMY:
+                case SPRITE_TYPE_DOOR:
+                case SPRITE_TYPE_LOCKED_DOOR:
+                case SPRITE_TYPE_ENDGAME:
+                    turn_sprite_away();
+                    break;
+            }
+            break;
+        // Nothing else cares about other sprites yet. Add a case here for any sprite type you want to react.
+        default:
+            break;
+    }
+}
+
+#endif
+
+// Temporary variables for find_player_sprite_collisions. (update_map_sprites is done with its own by now)
+#define playerGridColumn tempChar2
+#define playerGridRow tempChar3
+#define gridColumn tempChar4
+#define gridRow tempChar6
+#define spriteGridCandidates tempInt4
+
+void find_player_sprite_collisions() {
+    playerSpriteCollisionCount = 0;
+
+    // Which cell is the middle of the player in?
+    currentSpriteGridCell = SPRITE_GRID_CELL(
+        (unsigned char)((playerXPosition >> PLAYER_POSITION_SHIFT) + NES_SPRITE_WIDTH),
+        (unsigned char)((playerYPosition >> PLAYER_POSITION_SHIFT) + NES_SPRITE_HEIGHT)
+    );
+    playerGridColumn = currentSpriteGridCell & (SPRITE_GRID_COLUMNS - 1);
+    playerGridRow = currentSpriteGridCell >> (8 - SPRITE_GRID_CELL_SHIFT);
+
+    // Gather up every sprite in that cell, and the 8 cells around it. (Rows/columns off the edge of the grid wrap 
+    // around to 255, so the size check skips them too.)
+    spriteGridCandidates = 0;
+    for (gridRow = playerGridRow - 1; gridRow != playerGridRow + 2; ++gridRow) {
+        if (gridRow >= SPRITE_GRID_ROWS) {
+            continue;
+        }
+        for (gridColumn = playerGridColumn - 1; gridColumn != playerGridColumn + 2; ++gridColumn) {
+            if (gridColumn >= SPRITE_GRID_COLUMNS) {
+                continue;
+            }
+            spriteGridCandidates |= spriteGridCellMasks[(gridRow << (8 - SPRITE_GRID_CELL_SHIFT)) + gridColumn];
+        }
+    }
+
+    // Remember which sprites are near the player, so update_map_sprites can move the far away ones less often.
+    spriteNearPlayerMask = spriteGridCandidates;
+
+    // Now test just those sprites against the player. We shift the bits down as we go, and stop once there are none
+    // left, so the sprites far away from the player cost almost nothing.
+    for (i = 0; spriteGridCandidates != 0; ++i, spriteGridCandidates = (unsigned int)spriteGridCandidates >> 1) {
+        if (!(spriteGridCandidates & 0x01)) {
+            continue;
+        }
+
+        // Only test collision for sprite types that collide.
+        currentMapSpriteIndex = i << MAP_SPRITE_DATA_SHIFT;
+        currentSpriteType = currentMapSpriteData[(currentMapSpriteIndex) + MAP_SPRITE_DATA_POS_TYPE];
+        if (currentSpriteType == SPRITE_TYPE_NOTHING || currentSpriteType == SPRITE_TYPE_OFFSCREEN) {
+            continue;
+        }
+
+        // Find the top left of the sprite's hitbox.
+        sprX = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X + 1]) << 8)) + (spriteHitboxLeft[i] << SPRITE_POSITION_SHIFT);
+        sprY = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y + 1]) << 8)) + (spriteHitboxTop[i] << SPRITE_POSITION_SHIFT);
+
+        // Collision test... see here for a clear explanation: https://developer.mozilla.org/en-US/docs/Games/Techniques/2D_collision_detection
+        // rect1=player position, rect2=sprite position
+        // (RANGES_OVERLAP does the same comparisons, but still works if a box wraps around the edge of the screen.)
+        if (
+            RANGES_OVERLAP(playerXPosition, PLAYER_WIDTH_EXTENDED, sprX, spriteHitboxWidth[i] << SPRITE_POSITION_SHIFT) &&
+            RANGES_OVERLAP(playerYPosition, PLAYER_HEIGHT_EXTENDED, sprY, spriteHitboxHeight[i] << SPRITE_POSITION_SHIFT)
+        ) {
+            playerSpriteCollisionList[playerSpriteCollisionCount] = i;
+            ++playerSpriteCollisionCount;
+        }
     }
-}
\ No newline at end of file
+}
@@ -1,22 +1,209 @@
-#define PRG_BANK_MAP_SPRITES 2
-
-#define NO_SPRITE_HIT 255
-
 // Maximum number of keys to let the player pick up.
 #define MAX_KEY_COUNT 9
 
-// We make our 16x16 sprites a little bit smaller than they appear, so collisions with them are 
-// less likely. This makes getting hit by enemies less likely. This is only for collisions with 
-// the player.
-#define SPRITE_HITBOX_OFFSET 24
-// This does the same thing, but only for sprite collisions with tiles.
-#define SPRITE_TILE_HITBOX_OFFSET 10
+// Each sprite's hitboxes, copied from its definition when it's loaded, so we never have to work them out while the
+// game is running. All of these are in pixels from the top left of the sprite. (See the SPRITE_TILE_HITBOX_ and
+// SPRITE_HITBOX_ constants in sprite_definitions.h)
+// The box for bumping into walls. Right and bottom are the last pixel inside the box, since that's the pixel we test.
+extern unsigned char spriteTileHitboxLeft[MAP_SPRITE_SLOT_COUNT];
+extern unsigned char spriteTileHitboxTop[MAP_SPRITE_SLOT_COUNT];
+extern unsigned char spriteTileHitboxRight[MAP_SPRITE_SLOT_COUNT];
+extern unsigned char spriteTileHitboxBottom[MAP_SPRITE_SLOT_COUNT];
+// The box for touching the player and other sprites. This one has a width and height instead, since that's what
+// RANGES_OVERLAP wants.
+extern unsigned char spriteHitboxLeft[MAP_SPRITE_SLOT_COUNT];
+extern unsigned char spriteHitboxTop[MAP_SPRITE_SLOT_COUNT];
+extern unsigned char spriteHitboxWidth[MAP_SPRITE_SLOT_COUNT];
+extern unsigned char spriteHitboxHeight[MAP_SPRITE_SLOT_COUNT];
+
+// Every sprite that collided with the player this frame. (In the order of the sprites on the map) handle_player_sprite_collision
+// in player.c goes through these, so picking up a heart while an enemy hits you doesn't lose either one.
+ZEROPAGE_EXTERN(unsigned char, playerSpriteCollisionCount);
+extern unsigned char playerSpriteCollisionList[MAP_SPRITE_SLOT_COUNT];
+
+// To avoid testing every sprite against the player, the screen is split into a coarse grid of square cells, and we
+// keep track of which sprites are in each one. Each sprite is in the cell the middle of it is in. Sprites are small
+// compared to the cells, so the player can only touch sprites in the cells right around them. This is how many
+// pixels wide and tall a cell is, as a shift. (6 is 64 pixels; the room is 4 cells across and 3 down.)
+// NOTE: Sprites and the player need to be smaller than a cell for this to work.
+#define SPRITE_GRID_CELL_SHIFT 6
+#define SPRITE_GRID_COLUMNS (256 >> SPRITE_GRID_CELL_SHIFT)
+// We give the grid as many rows as columns, so any pixel on the screen has a cell. (The bottom row of cells is below
+// the room, so nothing is ever in it.)
+#define SPRITE_GRID_ROWS SPRITE_GRID_COLUMNS
+#define SPRITE_GRID_CELL_COUNT (SPRITE_GRID_COLUMNS * SPRITE_GRID_ROWS)
+// Used for sprites that aren't in the grid yet.
+#define SPRITE_GRID_NO_CELL 255
+
+// Which grid cell is the pixel at x, y on the screen in? Both need to be unsigned chars. (0-255)
+#define SPRITE_GRID_CELL(xPixel, yPixel) (((mapTileRowLookup[(yPixel)] >> SPRITE_GRID_CELL_SHIFT) << (8 - SPRITE_GRID_CELL_SHIFT)) + ((xPixel) >> SPRITE_GRID_CELL_SHIFT))
+
+// Which sprites are in each grid cell, with one bit per sprite. (Sprite 0 is 0x01, sprite 1 is 0x02, etc)
+extern MAP_SPRITE_MASK spriteGridCellMasks[SPRITE_GRID_CELL_COUNT];
+// Which grid cell each sprite is in, or SPRITE_GRID_NO_CELL.
+extern unsigned char spriteGridCellForSprite[MAP_SPRITE_SLOT_COUNT];
+
+// Sprites can also bump into each other - enemies turn around instead of walking through each other or through doors.
+// Set this to 0 to turn that off and save some cpu time.
+#define SPRITE_SPRITE_COLLISIONS 1
+// The most pairs of touching sprites we deal with in one pass. Any more than this wait until the next pass, which starts
+// where this one stopped; this keeps a room full of sprites piled on top of each other from slowing the game down.
+#define SPRITE_SPRITE_COLLISION_MAX_PAIRS 8
+
+// ===== Sprite AI scheduling
+// Moving sprites is the most expensive thing we do each frame, so we don't move every sprite every frame. Instead, the
+// scheduler picks a cycle of 1, 2 or 4 frames, and gives each moving sprite one frame in that cycle to move on. It
+// picks the shortest cycle that keeps the work done on any one frame under SPRITE_AI_FRAME_BUDGET, and spreads the
+// sprites out so each frame in the cycle does about the same amount of work. Sprites that move less often move further
+// each time, so they still cover the same distance. A room with a couple of enemies gets every sprite moved every
+// frame, and a crowded room takes about the same amount of time every frame instead of slowing down.
+
+// Roughly how much time each movement type takes, in units of about 100 cpu cycles. These are in map_sprites.c, next
+// to spriteMovementHandlers. (make frame_cost can help you find good numbers for your own movement types)
+// How much movement work we let ourselves do in one frame, in the same units.
+#define SPRITE_AI_FRAME_BUDGET 40
+// The longest cycle the scheduler can use, as a shift. (2 is 4 frames) Sprites move further each time in a longer
+// cycle, and they have to stay under 16 pixels per move to not skip over walls, so be careful raising this.
+#define SPRITE_AI_MAX_SCHEDULE_SHIFT 2
+// Sprites far from the player (outside of the sprite grid cells around them) are moved half as often, unless we're
+// already using the longest cycle. Set this to 0 to move every sprite on its turn.
+#define SPRITE_AI_FAR_SLOWDOWN 1
+// Used for spriteSchedulePhase for sprites that don't move, and sprite slots that are empty.
+#define SPRITE_NOT_SCHEDULED 255
+
+// How long the current cycle is, as a shift. (0 is every frame, 1 is every other frame, 2 is every 4th frame)
+extern unsigned char spriteScheduleShift;
+// Which frame of the cycle each sprite moves on, or SPRITE_NOT_SCHEDULED.
+extern unsigned char spriteSchedulePhase[MAP_SPRITE_SLOT_COUNT];
+// Set this to have the scheduler run again when the next cycle starts. New sprites and sprites that go away are fit
+// into the current schedule; this only gets set when that leaves the cycle too long or too short.
+extern unsigned char spriteScheduleDirty;
+// The frame of the cycle we're on. load_sprites sets this to the last one, so a new room starts a new cycle.
+extern unsigned char spriteScheduleFrame;
+// The sprites near the player, with the same bits as spriteGridCellMasks. Filled in by find_player_sprite_collisions.
+extern MAP_SPRITE_MASK spriteNearPlayerMask;
+
+// ===== Chasing the player
+// Sprites with SPRITE_MOVEMENT_CHASE find their way to the player around walls. Rather than each one searching for a
+// path, we keep one map of the room that says, for every open tile, which way to step to get one tile closer to the
+// player. (This is called a flow field) Every chasing sprite reads the same map, so 5 chasers cost about the same as 1.
+// The map is built with a breadth-first search out from the player's tile. That's too much work to do in one frame,
+// so it's done a few tiles at a time, and started over whenever the player steps onto a new tile. While the new search
+// is spreading out, tiles it hasn't reached yet keep the direction from the last one, which is still a good way to go.
+// The search only runs in rooms that have a chasing sprite in them.
+
+// How many tiles the search finishes each frame. Each one is roughly 400 cpu cycles. A room is 192 tiles, but walls
+// are skipped, so most rooms are done in 10-20 frames.
+#define SPRITE_FLOW_TILES_PER_FRAME 8
+// Used for spriteFlowTargetTile when we don't have a search yet, like right after a room loads.
+#define SPRITE_FLOW_NO_TILE 255
+
+// Which way to step from each tile of the room to get closer to the player. (A SPRITE_DIRECTION_ value; the player's
+// own tile is SPRITE_DIRECTION_STATIONARY) Only good for tiles where SPRITE_FLOW_IS_CURRENT is true.
+extern unsigned char spriteFlowDirection[MAP_DATA_TILE_LENGTH];
+// Which search set each tile's direction. Each search gets the next number; 0 means none has.
+extern unsigned char spriteFlowSearchId[MAP_DATA_TILE_LENGTH];
+extern unsigned char spriteFlowCurrentSearchId;
+// The tile the current search started from.
+extern unsigned char spriteFlowTargetTile;
+// Is there a chasing sprite in the room? The scheduler keeps this up to date.
+extern unsigned char spriteFlowActive;
+
+// Does the flow field have a direction for this tile, from either the current search or the last one?
+#define SPRITE_FLOW_IS_CURRENT(mapIndex) ((unsigned char)(spriteFlowCurrentSearchId - spriteFlowSearchId[(mapIndex)]) < 2)
+
+// Throw the flow field away, so the next search starts fresh. load_sprites calls this for each new room.
+void reset_sprite_flow_field();
+
+// Work on the flow field for up to SPRITE_FLOW_TILES_PER_FRAME tiles. Called by update_map_sprites in rooms with
+// chasing sprites.
+void update_sprite_flow_field();
 
-// The last sprite id that collided with the player, if any. Otherwise, set to NO_SPRITE_HIT
-ZEROPAGE_EXTERN(unsigned char, lastPlayerSpriteCollisionId);
+// ===== Sleeping sprites
+// Sprites that never move or animate (like hearts and keys) look exactly the same every frame, so there's no point in
+// working out their sprites in OAM every frame. The first time update_map_sprites draws one, it saves a copy of its
+// 4 OAM entries, and from then on the sprite is asleep: it only gets copied back into OAM when the flicker order puts
+// it somewhere new. Empty slots are the same; they get hidden once, and again only when the flicker order changes.
+// Use REDRAW_MAP_SPRITE if you change how a sprite looks (tile, palette or position) from outside of update_map_sprites.
+
+// Values for spriteOamState.
+// The sprite needs to be drawn the long way next time. Sprites that move or animate always stay like this.
+#define SPRITE_OAM_REDRAW 0
+// The sprite is asleep, and its OAM entries are saved in spriteOamCache.
+#define SPRITE_OAM_ASLEEP 1
+// The slot is empty, and its OAM entries have been hidden.
+#define SPRITE_OAM_HIDDEN 2
+
+extern unsigned char spriteOamState[MAP_SPRITE_SLOT_COUNT];
+// The last OAM entries drawn for each sleeping sprite; 4 entries of 4 bytes for each slot.
+extern unsigned char spriteOamCache[MAP_SPRITE_SLOT_COUNT << MAP_SPRITE_OAM_SHIFT];
+
+// Wake a sprite up, so update_map_sprites draws it again. init_map_sprite does this for new sprites.
+#define REDRAW_MAP_SPRITE(spriteId) spriteOamState[(spriteId)] = SPRITE_OAM_REDRAW
+
+// The sprite ids on this map, sorted from left to right. The order barely changes from one frame to the next, so
+// keeping it sorted is cheap. load_sprites resets it.
+extern unsigned char spriteSortOrder[MAP_SPRITE_SLOT_COUNT];
+
+// Used for spawnedSpriteId when there was no free slot for a new sprite.
+#define NO_SPRITE_SLOT 255
+
+// Spawning sprites: set spawnSpriteDefinitionId, spawnSpriteX and spawnSpriteY, then call spawn_map_sprite. (Use
+// banked_call(PRG_BANK_MAP_SPRITES, spawn_map_sprite) if you're not in map_sprites.c) The id of the new sprite ends up
+// in spawnedSpriteId, or NO_SPRITE_SLOT if all MAP_MAX_SPAWNED_SPRITES slots are in use.
+// The definition id is the same number you'd use for the sprite in Tiled, and x/y are the pixel on the screen for the
+// top left of the sprite.
+extern unsigned char spawnSpriteDefinitionId;
+extern unsigned char spawnSpriteX;
+extern unsigned char spawnSpriteY;
+extern unsigned char spawnedSpriteId;
+
+// The spawn slots that are free, used as a stack so spawning and freeing a slot are both just one step.
+// update_map_sprites puts a slot back on here the first time it sees the sprite in it is gone.
+extern unsigned char spawnedSpriteFreeList[MAP_MAX_SPAWNED_SPRITES];
+extern unsigned char spawnedSpriteFreeCount;
+// One bit per spawn slot, set while the slot is on the free list, so it doesn't get added twice.
+extern unsigned char spawnedSpriteFreeMask;
+
+// Remove a sprite from the map. This works for both sprites from the map and spawned sprites; a spawned sprite's
+// slot goes back to the pool on the next call to update_map_sprites.
+#define DESPAWN_MAP_SPRITE(spriteId) currentMapSpriteData[((spriteId) << MAP_SPRITE_DATA_SHIFT) + MAP_SPRITE_DATA_POS_TYPE] = SPRITE_TYPE_OFFSCREEN
+
+// Find where each animation type's sequence starts in spriteAnimationSequences. Call this once, before any sprites are
+// loaded.
+void init_sprite_animations();
+
+// Put a new sprite on the map, using the spawn variables above.
+void spawn_map_sprite();
+
+// Fill in the sprite slot spawnedSpriteId from the spawn variables above, without touching the free list.
+// load_sprites uses this for the map's own sprites; you probably want spawn_map_sprite instead.
+void init_map_sprite();
 
 // Update all sprites on the current map tile. You probably want to call this 1x/frame.
 void update_map_sprites();
 
+// Pick the schedule cycle length, and which frame of it each sprite moves on. update_map_sprites calls this at the
+// start of a cycle when spriteScheduleDirty is set.
+void schedule_map_sprites();
+
+// Give the sprite in spawnedSpriteId a turn in the current schedule, without moving anyone else. init_map_sprite calls
+// this.
+void schedule_new_map_sprite();
+
+// Fill in playerSpriteCollisionList with every sprite touching the player, using the sprite grid. Called at the end
+// of update_map_sprites.
+void find_player_sprite_collisions();
+
+// Find every pair of sprites touching each other, and call handle_sprite_sprite_collision for both sprites in each
+// pair. Called from update_map_sprites once per schedule cycle, if SPRITE_SPRITE_COLLISIONS is on.
+void find_sprite_sprite_collisions();
+
+// React to spriteCollisionId touching spriteCollisionOtherId. (Both are sprite ids on the map, like `i` in
+// update_map_sprites) This has a case for each sprite type, like handle_player_sprite_collision does for the player.
+void handle_sprite_sprite_collision();
+
 // Little helper to turn an X,Y position to a tile on the map
-#define SPRITE_MAP_POSITION(xPos, yPos) ((xPos)>>(SPRITE_POSITION_SHIFT+4)) + (((yPos >> SPRITE_POSITION_SHIFT) - HUD_PIXEL_HEIGHT) & 0xf0)
+#define SPRITE_MAP_POSITION(xPos, yPos) MAP_POSITION_FROM_PIXELS((unsigned char)((xPos) >> SPRITE_POSITION_SHIFT), (unsigned char)((yPos) >> SPRITE_POSITION_SHIFT))
+// Is the tile on the map at this position solid? (Uses the collision bitmap load_map builds; see map.h)
+#define SPRITE_MAP_SOLID(xPos, yPos) MAP_INDEX_IS_SOLID(SPRITE_MAP_POSITION(xPos, yPos))
@@ -8,19 +8,22 @@
 #include "source/sprites/collision.h"
 #include "source/sprites/sprite_definitions.h"
 #include "source/sprites/map_sprites.h"
+#include "source/library/input_recorder.h"
 #include "source/menus/error.h"
 #include "source/graphics/hud.h"
 
 CODE_BANK(PRG_BANK_PLAYER_SPRITE);
 
 // Some useful global variables
-ZEROPAGE_DEF(int, playerXPosition);
-ZEROPAGE_DEF(int, playerYPosition);
+ZEROPAGE_DEF(unsigned int, playerXPosition);
+ZEROPAGE_DEF(unsigned int, playerYPosition);
 ZEROPAGE_DEF(int, playerXVelocity);
 ZEROPAGE_DEF(int, playerYVelocity);
 ZEROPAGE_DEF(unsigned char, playerControlsLockTime);
 ZEROPAGE_DEF(unsigned char, playerInvulnerabilityTime);
 ZEROPAGE_DEF(unsigned char, playerDirection);
+unsigned char playerAnimationFrame;
+unsigned char playerAnimationTime;
 
 // Huge pile of temporary variables
 #define rawXPosition tempChar1
@@ -30,6 +33,16 @@ ZEROPAGE_DEF(unsigned char, playerDirection);
 #define collisionTempY tempChar5
 #define collisionTempXRight tempChar6
 #define collisionTempYBottom tempChar7
+#define collisionHitFirst tempChar8
+#define collisionHitSecond tempChar9
+#define collisionTempDirection tempChara
+// Only used in update_player_sprite, which doesn't need any of the collision variables.
+#define rawSpriteAttributes tempChar4
+#define rawFlipColumn tempChar5
+
+#define collisionEdge tempInt3
+#define collisionMove tempInt4
+#define collisionNudge tempInt5
 
 #define tempSpriteCollisionX tempInt1
 #define tempSpriteCollisionY tempInt2
@@ -40,10 +53,25 @@ void update_player_sprite() {
     rawXPosition = (playerXPosition >> PLAYER_POSITION_SHIFT);
     rawYPosition = (playerYPosition >> PLAYER_POSITION_SHIFT);
     rawTileId = PLAYER_SPRITE_TILE_ID + playerDirection;
+    rawSpriteAttributes = 0x00;
+    rawFlipColumn = 0;
+    #if PLAYER_FLIP_LEFT
+        if (playerDirection == SPRITE_DIRECTION_LEFT) {
+            // Draw the right-facing tiles mirrored. The left and right columns of tiles swap places too, or each
+            // half would be flipped in place.
+            rawTileId = PLAYER_SPRITE_TILE_ID + SPRITE_DIRECTION_RIGHT;
+            rawSpriteAttributes = OAM_FLIP_H;
+            rawFlipColumn = 1;
+        }
+    #endif
 
     if (playerXVelocity != 0 || playerYVelocity != 0) {
-        // Does some math with the current NES frame to add either 2 or 0 to the tile id, animating the sprite.
-        rawTileId += ((frameCount >> SPRITE_ANIMATION_SPEED_DIVISOR) & 0x01) << 1;
+        // Play the walking animation. The player is 16x16, so each frame is 2 tiles across.
+        STEP_SPRITE_ANIMATION(playerAnimationFrame, playerAnimationTime, spriteAnimationSequenceStart[PLAYER_WALK_ANIMATION]);
+        rawTileId += spriteAnimationSequences[playerAnimationFrame] << 1;
+    } else {
+        // Standing still; start from the first frame next time we walk.
+        START_SPRITE_ANIMATION(playerAnimationFrame, playerAnimationTime, spriteAnimationSequenceStart[PLAYER_WALK_ANIMATION]);
     }
     
     if (playerInvulnerabilityTime && frameCount & PLAYER_INVULNERABILITY_BLINK_MASK) {
@@ -54,10 +82,10 @@ void update_player_sprite() {
         oam_spr(SPRITE_OFFSCREEN, SPRITE_OFFSCREEN, rawTileId + 17, 0x00, PLAYER_SPRITE_INDEX+12);
 
     } else {
-        oam_spr(rawXPosition, rawYPosition, rawTileId, 0x00, PLAYER_SPRITE_INDEX);
-        oam_spr(rawXPosition + NES_SPRITE_WIDTH, rawYPosition, rawTileId + 1, 0x00, PLAYER_SPRITE_INDEX+4);
-        oam_spr(rawXPosition, rawYPosition + NES_SPRITE_HEIGHT, rawTileId + 16, 0x00, PLAYER_SPRITE_INDEX+8);
-        oam_spr(rawXPosition + NES_SPRITE_WIDTH, rawYPosition + NES_SPRITE_HEIGHT, rawTileId + 17, 0x00, PLAYER_SPRITE_INDEX+12);
+        oam_spr(rawXPosition, rawYPosition, rawTileId + rawFlipColumn, rawSpriteAttributes, PLAYER_SPRITE_INDEX);
+        oam_spr(rawXPosition + NES_SPRITE_WIDTH, rawYPosition, rawTileId + 1 - rawFlipColumn, rawSpriteAttributes, PLAYER_SPRITE_INDEX+4);
+        oam_spr(rawXPosition, rawYPosition + NES_SPRITE_HEIGHT, rawTileId + 16 + rawFlipColumn, rawSpriteAttributes, PLAYER_SPRITE_INDEX+8);
+        oam_spr(rawXPosition + NES_SPRITE_WIDTH, rawYPosition + NES_SPRITE_HEIGHT, rawTileId + 17 - rawFlipColumn, rawSpriteAttributes, PLAYER_SPRITE_INDEX+12);
     }
 
 }
@@ -67,7 +95,7 @@ void handle_player_movement() {
     // or whatever you like!
     int maxVelocity = PLAYER_MAX_VELOCITY;
     lastControllerState = controllerState;
-    controllerState = pad_poll(0);
+    controllerState = input_pad_poll(0);
 
     // If Start is pressed now, and was not pressed before...
     if (controllerState & PAD_START && !(lastControllerState & PAD_START)) {
@@ -149,88 +177,164 @@ void handle_player_movement() {
     } else if (rawYPosition > SCREEN_EDGE_BOTTOM) {
         playerDirection = SPRITE_DIRECTION_DOWN;
         gameState = GAME_STATE_SCREEN_SCROLL;
-        playerOverworldPosition += 8;
+        playerOverworldPosition += OVERWORLD_WIDTH;
     } else if (rawYPosition < SCREEN_EDGE_TOP) {
         playerDirection = SPRITE_DIRECTION_UP;
         gameState = GAME_STATE_SCREEN_SCROLL;
-        playerOverworldPosition -= 8;
+        playerOverworldPosition -= OVERWORLD_WIDTH;
     }
 }
 
-void test_player_tile_collision() {
+// Moves the player up or down by collisionMove, and stops them flush against the first solid tile in the way. The
+// player's box can only run into something when its leading edge crosses into a new row of tiles, so that's the only
+// time we look at the map, and then only at the (at most 2) tiles in that row. Returns 1 if the player was stopped.
+// If only one of the 2 tiles was solid, and the player overlaps it by PLAYER_CORNER_NUDGE_DISTANCE or less,
+// collisionNudge is set to push them sideways around the corner.
+// Anything outside of the room is never solid, (see mapTileRowLookup in map.h) so the player can always walk off the
+// edge of the screen.
+// NOTE: This assumes the player moves less than a full tile (16 pixels) in one frame.
+unsigned char move_player_y() {
+    // The leading edge of the box. (Still with sub-pixels)
+    collisionEdge = playerYPosition + PLAYER_Y_OFFSET_EXTENDED;
+    if (collisionMove > 0) {
+        collisionEdge += PLAYER_HEIGHT_EXTENDED;
+    }
+    playerYPosition += collisionMove;
 
-	if (playerYVelocity != 0) {
-		collisionTempY = ((playerYPosition + PLAYER_Y_OFFSET_EXTENDED + playerYVelocity) >> PLAYER_POSITION_SHIFT) - HUD_PIXEL_HEIGHT;
-		collisionTempX = ((playerXPosition + PLAYER_X_OFFSET_EXTENDED) >> PLAYER_POSITION_SHIFT);
-        collisionTempYBottom = ((playerYPosition + PLAYER_Y_OFFSET_EXTENDED + playerYVelocity + PLAYER_HEIGHT_EXTENDED) >> PLAYER_POSITION_SHIFT) - HUD_PIXEL_HEIGHT;
-        collisionTempXRight = ((playerXPosition + PLAYER_X_OFFSET_EXTENDED + PLAYER_WIDTH_EXTENDED) >> PLAYER_POSITION_SHIFT);
+    // The high byte is the pixel on the screen. If that's still in the same row of tiles, nothing new can be in the way.
+    collisionTempY = (collisionEdge + collisionMove) >> PLAYER_POSITION_SHIFT;
+    collisionTempYBottom = collisionEdge >> PLAYER_POSITION_SHIFT;
+    if (mapTileRowLookup[collisionTempY] == mapTileRowLookup[collisionTempYBottom]) {
+        return 0;
+    }
 
-		if (playerYVelocity < 0) {
-            // We're going up - test the top left, and top right
-			if (test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempX, collisionTempY)], 1) || test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempXRight, collisionTempY)], 1)) {
-                playerYVelocity = 0;
-                playerControlsLockTime = 0;
-            }
-            if (!playerControlsLockTime) {
-                playerDirection = SPRITE_DIRECTION_UP;
-            }
-		} else {
-            // Okay, we're going down - test the bottom left and bottom right
-			if (test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempX, collisionTempYBottom)], 1) || test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempXRight, collisionTempYBottom)], 1)) {
-                playerYVelocity = 0;
-                playerControlsLockTime = 0;
+    // The pixels at the left and right of the box.
+    collisionTempX = (playerXPosition + PLAYER_X_OFFSET_EXTENDED) >> PLAYER_POSITION_SHIFT;
+    collisionTempXRight = (playerXPosition + (PLAYER_X_OFFSET_EXTENDED + PLAYER_WIDTH_EXTENDED)) >> PLAYER_POSITION_SHIFT;
+    collisionHitFirst = is_solid(collisionTempX, collisionTempY);
+    collisionHitSecond = mapTileColumnLookup[collisionTempXRight] != mapTileColumnLookup[collisionTempX] && is_solid(collisionTempXRight, collisionTempY);
+    if (!collisionHitFirst && !collisionHitSecond) {
+        return 0;
+    }
 
-			}
-            if (!playerControlsLockTime) {
-                playerDirection = SPRITE_DIRECTION_DOWN;
-            }
-		}
+    // Put the player right up against the tile they hit. (The row lookup gives us the row times 16, which is how far
+    // the top of the tile is from the top of the map, in pixels.)
+    if (collisionMove > 0) {
+        playerYPosition = ((unsigned int)(mapTileRowLookup[collisionTempY] + HUD_PIXEL_HEIGHT) << PLAYER_POSITION_SHIFT) - (1 + PLAYER_HEIGHT_EXTENDED + PLAYER_Y_OFFSET_EXTENDED);
+    } else {
+        playerYPosition = ((unsigned int)(mapTileRowLookup[collisionTempY] + (16 + HUD_PIXEL_HEIGHT)) << PLAYER_POSITION_SHIFT) - PLAYER_Y_OFFSET_EXTENDED;
     }
 
-	if (playerXVelocity != 0) {
-		collisionTempX = (playerXPosition + PLAYER_X_OFFSET_EXTENDED + playerXVelocity) >> PLAYER_POSITION_SHIFT;
-		collisionTempY = ((playerYPosition + PLAYER_Y_OFFSET_EXTENDED + playerYVelocity) >> PLAYER_POSITION_SHIFT) - HUD_PIXEL_HEIGHT;
-        collisionTempYBottom = ((playerYPosition + PLAYER_Y_OFFSET_EXTENDED + playerYVelocity + PLAYER_HEIGHT_EXTENDED) >> PLAYER_POSITION_SHIFT) - HUD_PIXEL_HEIGHT;
-        collisionTempXRight = ((playerXPosition + PLAYER_X_OFFSET_EXTENDED + playerXVelocity + PLAYER_WIDTH_EXTENDED) >> PLAYER_POSITION_SHIFT);
+    // Only clipped a corner? Slide around it. (If the box is all in one column, the overlap is too big for this.)
+    if (!collisionHitSecond) {
+        if (16 - (collisionTempX & 0x0f) <= PLAYER_CORNER_NUDGE_DISTANCE) {
+            collisionNudge = PLAYER_CORNER_NUDGE_SPEED;
+        }
+    } else if (!collisionHitFirst) {
+        if ((collisionTempXRight & 0x0f) < PLAYER_CORNER_NUDGE_DISTANCE) {
+            collisionNudge = 0 - PLAYER_CORNER_NUDGE_SPEED;
+        }
+    }
+    return 1;
+}
 
+// The same as move_player_y, but left and right. (A corner nudge from here pushes the player up or down.)
+unsigned char move_player_x() {
+    collisionEdge = playerXPosition + PLAYER_X_OFFSET_EXTENDED;
+    if (collisionMove > 0) {
+        collisionEdge += PLAYER_WIDTH_EXTENDED;
+    }
+    playerXPosition += collisionMove;
 
-        // Depending on how far to the left/right the player is, there's a chance part of our bounding box falls into
-        // the next column of tiles on the opposite side of the screen. This if statement prevents those collisions.
-        if (collisionTempX > 2 && collisionTempX < 238) {
-            if (playerXVelocity < 0) {
-                // Okay, we're moving left. Need to test the top-left and bottom-left
-                if (test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempX, collisionTempY)], 1) || test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempX, collisionTempYBottom)], 1)) {
-                    playerXVelocity = 0;
-                    playerControlsLockTime = 0;
+    collisionTempX = (collisionEdge + collisionMove) >> PLAYER_POSITION_SHIFT;
+    collisionTempXRight = collisionEdge >> PLAYER_POSITION_SHIFT;
+    if (mapTileColumnLookup[collisionTempX] == mapTileColumnLookup[collisionTempXRight]) {
+        return 0;
+    }
 
-                }
-                if (!playerControlsLockTime) {
-                    playerDirection = SPRITE_DIRECTION_LEFT;
-                }
-            } else {
-                // Going right - need to test top-right and bottom-right
-                if (test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempXRight, collisionTempY)], 1) || test_collision(currentMap[PLAYER_MAP_POSITION(collisionTempXRight, collisionTempYBottom)], 1)) {
-                    playerXVelocity = 0;
-                    playerControlsLockTime = 0;
+    // The pixels at the top and bottom of the box.
+    collisionTempY = (playerYPosition + PLAYER_Y_OFFSET_EXTENDED) >> PLAYER_POSITION_SHIFT;
+    collisionTempYBottom = (playerYPosition + (PLAYER_Y_OFFSET_EXTENDED + PLAYER_HEIGHT_EXTENDED)) >> PLAYER_POSITION_SHIFT;
+    collisionHitFirst = is_solid(collisionTempX, collisionTempY);
+    collisionHitSecond = mapTileRowLookup[collisionTempYBottom] != mapTileRowLookup[collisionTempY] && is_solid(collisionTempX, collisionTempYBottom);
+    if (!collisionHitFirst && !collisionHitSecond) {
+        return 0;
+    }
 
-                }
-                if (!playerControlsLockTime) {
-                    playerDirection = SPRITE_DIRECTION_RIGHT;
-                }
+    if (collisionMove > 0) {
+        playerXPosition = ((unsigned int)(collisionTempX & 0xf0) << PLAYER_POSITION_SHIFT) - (1 + PLAYER_WIDTH_EXTENDED + PLAYER_X_OFFSET_EXTENDED);
+    } else {
+        playerXPosition = ((unsigned int)((collisionTempX & 0xf0) + 16) << PLAYER_POSITION_SHIFT) - PLAYER_X_OFFSET_EXTENDED;
+    }
+
+    // (Rows of tiles start at the bottom of the HUD, so take that out before checking how far into the tile we are.)
+    if (!collisionHitSecond) {
+        if (16 - ((collisionTempY - HUD_PIXEL_HEIGHT) & 0x0f) <= PLAYER_CORNER_NUDGE_DISTANCE) {
+            collisionNudge = PLAYER_CORNER_NUDGE_SPEED;
+        }
+    } else if (!collisionHitFirst) {
+        if (((collisionTempYBottom - HUD_PIXEL_HEIGHT) & 0x0f) < PLAYER_CORNER_NUDGE_DISTANCE) {
+            collisionNudge = 0 - PLAYER_CORNER_NUDGE_SPEED;
+        }
+    }
+    return 1;
+}
+
+void test_player_tile_collision() {
+    collisionNudge = 0;
+
+    // Up and down first. If the player clips a corner, the nudge around it gets added to the left/right movement.
+    if (playerYVelocity != 0) {
+        collisionMove = playerYVelocity;
+        collisionTempDirection = (playerYVelocity < 0) ? SPRITE_DIRECTION_UP : SPRITE_DIRECTION_DOWN;
+        if (move_player_y()) {
+            playerYVelocity = 0;
+            playerControlsLockTime = 0;
+        }
+        if (!playerControlsLockTime) {
+            playerDirection = collisionTempDirection;
+        }
+    }
+
+    // Then left and right, from wherever up/down left us. Since each direction is handled on its own, running into a
+    // wall at an angle only stops you in one direction; you slide along it in the other.
+    if (playerXVelocity != 0 || collisionNudge != 0) {
+        collisionMove = playerXVelocity + collisionNudge;
+        collisionNudge = 0;
+        // We only turn the player if they're the one moving, not if they're getting nudged around a corner.
+        if (playerXVelocity != 0) {
+            collisionTempDirection = (playerXVelocity < 0) ? SPRITE_DIRECTION_LEFT : SPRITE_DIRECTION_RIGHT;
+            if (move_player_x()) {
+                playerXVelocity = 0;
+                playerControlsLockTime = 0;
+            }
+            if (!playerControlsLockTime) {
+                playerDirection = collisionTempDirection;
             }
+        } else {
+            move_player_x();
         }
-	}
+    }
 
-    playerXPosition += playerXVelocity;
-    playerYPosition += playerYVelocity;
+    // Lastly, if running into a wall sideways clipped a corner, nudge the player up or down around it.
+    if (collisionNudge != 0) {
+        collisionMove = collisionNudge;
+        move_player_y();
+    }
 
 }
 
 #define currentMapSpriteIndex tempChar1
+#define currentSpriteHitIndex tempChar2
+#define currentSpriteHitId tempChar3
+#define hasPushedBackFromDoor tempChar4
 void handle_player_sprite_collision() {
-    // We store the last sprite hit when we update the sprites in `map_sprites.c`, so here all we have to do is react to it.
-    if (lastPlayerSpriteCollisionId != NO_SPRITE_HIT) {
-        currentMapSpriteIndex = lastPlayerSpriteCollisionId<<MAP_SPRITE_DATA_SHIFT;
+    // We store every sprite the player touched when we update the sprites in `map_sprites.c`, so here all we have to
+    // do is react to each of them.
+    hasPushedBackFromDoor = 0;
+    for (currentSpriteHitIndex = 0; currentSpriteHitIndex != playerSpriteCollisionCount; ++currentSpriteHitIndex) {
+        currentSpriteHitId = playerSpriteCollisionList[currentSpriteHitIndex];
+        currentMapSpriteIndex = currentSpriteHitId<<MAP_SPRITE_DATA_SHIFT;
 
         switch (currentMapSpriteData[(currentMapSpriteIndex) + MAP_SPRITE_DATA_POS_TYPE]) {
             case SPRITE_TYPE_HEALTH:
@@ -247,7 +351,7 @@ void handle_player_sprite_collision() {
                     sfx_play(SFX_HEART, SFX_CHANNEL_3);
 
                     // Mark the sprite as collected, so we can't get it again.
-                    currentMapSpritePersistance[playerOverworldPosition] |= bitToByte[lastPlayerSpriteCollisionId];
+                    PERSIST_MAP_SPRITE(currentSpriteHitId);
                 }
                 break;
             case SPRITE_TYPE_KEY:
@@ -258,13 +362,14 @@ void handle_player_sprite_collision() {
                     sfx_play(SFX_KEY, SFX_CHANNEL_3);
 
                     // Mark the sprite as collected, so we can't get it again.
-                    currentMapSpritePersistance[playerOverworldPosition] |= bitToByte[lastPlayerSpriteCollisionId];
+                    PERSIST_MAP_SPRITE(currentSpriteHitId);
                 }
                 break;
             case SPRITE_TYPE_REGULAR_ENEMY:
 
+                // Still invulnerable from the last hit? Skip this one, but keep checking the rest of the list.
                 if (playerInvulnerabilityTime) {
-                    return;
+                    break;
                 }
                 playerHealth -= currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_DAMAGE]; 
                 // Since playerHealth is unsigned, we need to check for wraparound damage. 
@@ -309,29 +414,31 @@ void handle_player_sprite_collision() {
                     currentMapSpriteData[(currentMapSpriteIndex) + MAP_SPRITE_DATA_POS_TYPE] = SPRITE_TYPE_OFFSCREEN;
 
                     // Mark the door as gone, so it doesn't come back.
-                    currentMapSpritePersistance[playerOverworldPosition] |= bitToByte[lastPlayerSpriteCollisionId];
+                    PERSIST_MAP_SPRITE(currentSpriteHitId);
 
                     break;
                 }
-                // So you don't have a key...
+                // So you don't have a key... If we already pushed the player back out of another door this frame,
+                // we're done - doing it twice would move them too far.
+                if (hasPushedBackFromDoor) {
+                    break;
+                }
                 // Okay, we collided with a door before we calculated the player's movement. After being moved, does the 
                 // new player position also collide? If so, stop it. Else, let it go.
 
-                // Calculate position...
-                tempSpriteCollisionX = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X + 1]) << 8));
-                tempSpriteCollisionY = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y + 1]) << 8));
+                // Calculate the position of the door's hitbox...
+                tempSpriteCollisionX = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_X + 1]) << 8)) + (spriteHitboxLeft[currentSpriteHitId] << PLAYER_POSITION_SHIFT);
+                tempSpriteCollisionY = ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y]) + ((currentMapSpriteData[currentMapSpriteIndex + MAP_SPRITE_DATA_POS_Y + 1]) << 8)) + (spriteHitboxTop[currentSpriteHitId] << PLAYER_POSITION_SHIFT);
 
                 // Are we colliding?
-                // NOTE: We take a bit of a shortcut here and assume all doors are 16x16 (the hard-coded 16 value below)
                 if (
-                    playerXPosition < tempSpriteCollisionX + (16 << PLAYER_POSITION_SHIFT) &&
-                    playerXPosition + PLAYER_WIDTH_EXTENDED > tempSpriteCollisionX &&
-                    playerYPosition < tempSpriteCollisionY + (16 << PLAYER_POSITION_SHIFT) &&
-                    playerYPosition + PLAYER_HEIGHT_EXTENDED > tempSpriteCollisionY
+                    RANGES_OVERLAP(playerXPosition, PLAYER_WIDTH_EXTENDED, tempSpriteCollisionX, spriteHitboxWidth[currentSpriteHitId] << PLAYER_POSITION_SHIFT) &&
+                    RANGES_OVERLAP(playerYPosition, PLAYER_HEIGHT_EXTENDED, tempSpriteCollisionY, spriteHitboxHeight[currentSpriteHitId] << PLAYER_POSITION_SHIFT)
                 ) {
                     playerXPosition -= playerXVelocity;
                     playerYPosition -= playerYVelocity;
                     playerControlsLockTime = 0;
+                    hasPushedBackFromDoor = 1;
                 }
                 break;
             case SPRITE_TYPE_ENDGAME:
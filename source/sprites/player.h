@@ -1,28 +1,41 @@
 #include "source/library/bank_helpers.h"
-#define PRG_BANK_PLAYER_SPRITE 2
-
 // Top-left tile of the sprite of the player facing downward.
 #define PLAYER_SPRITE_TILE_ID 0x00
 
+// When the player faces left, mirror the right-facing tiles instead of using the left-facing ones. (Like
+// SPRITE_FLIP_LEFT for map sprites.) Set this to 0 if you want to draw the player differently when facing left.
+#define PLAYER_FLIP_LEFT 1
+
 // The id of the first sprite in the 4 sprites comprising the player. (out of 64 total sprites)
 #define PLAYER_SPRITE_INDEX 0x10
 
-// This is the width and height of player as used in collisions. This is shifted by 4 to allow for sub-pixel
-// sizes. (And smoother acceleration/deceleration.) A 16px wide sprite is 256 units here.
-#define PLAYER_WIDTH_EXTENDED 205
-#define PLAYER_HEIGHT_EXTENDED 240
-#define PLAYER_X_OFFSET_EXTENDED 28
-#define PLAYER_Y_OFFSET_EXTENDED 16
+// This is the width and height of player as used in collisions. These use the same units as the player's position,
+// to allow for sub-pixel sizes. (1 pixel is 256 units, so a 16px wide sprite is 4096 units here.)
+#define PLAYER_WIDTH_EXTENDED 3280
+#define PLAYER_HEIGHT_EXTENDED 3840
+#define PLAYER_X_OFFSET_EXTENDED 448
+#define PLAYER_Y_OFFSET_EXTENDED 256
 
-// We store extra detail about the player's position to make movement smoother. This is how much to shift
-// by to get to the real location. (Think about this as dividing by 2^(this number))
-#define PLAYER_POSITION_SHIFT 4
+// We store extra detail about the player's position to make movement smoother. Positions are "8.8 fixed point":
+// the high byte is the pixel on the screen, and the low byte is how far (out of 256) the player is into the next
+// pixel. This is how much to shift by to get to the real location. (Think about this as dividing by 2^(this number))
+// NOTE: Since this is exactly one byte, the compiler doesn't actually shift anything - it just grabs the high byte.
+#define PLAYER_POSITION_SHIFT 8
 
 // Handles player movement - we start slow and accelerate/decelerate up to a max speed. As a player,
 // you probably won't notice this outright, but it feels a lot more natural like this.
-// NOTE: The max velocity needs to be evenly divided by the acceleration. (Eg 20/4 = 5)
-#define PLAYER_MAX_VELOCITY 20 // Max speed of the player; we won't let you go past this.
-#define PLAYER_VELOCITY_ACCEL 4 // How quickly do we get up to max velocity? 
+// These are in the same units as the position, so 256 is 1 pixel per frame.
+// NOTE: The max velocity needs to be evenly divided by the acceleration. (Eg 320/64 = 5)
+#define PLAYER_MAX_VELOCITY 320 // Max speed of the player; we won't let you go past this.
+#define PLAYER_VELOCITY_ACCEL 64 // How quickly do we get up to max velocity? 
+// NOTE: Tile collisions only look at the tiles the player moves into, so the player can never move 16 pixels (4096
+// units) or more in one frame, or they could skip right over a wall.
+
+// If the player walks into a wall and only just clips its corner, we push them around it instead of stopping them
+// dead. This is how many pixels of the corner they can be touching for that to happen...
+#define PLAYER_CORNER_NUDGE_DISTANCE 4
+// ... and how fast to push them, in the same units as velocity. (256 is 1 pixel per frame)
+#define PLAYER_CORNER_NUDGE_SPEED 256
 
 // If the player is damaged, how long do we lock their controls such that they bounce backwards?
 #define PLAYER_DAMAGE_CONTROL_LOCK_TIME 20
@@ -31,14 +44,21 @@
 // If the player is invulnerable, how quickly to we blink the sprite? In sprite mask form, so one of 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
 #define PLAYER_INVULNERABILITY_BLINK_MASK 0x02
 
-ZEROPAGE_EXTERN(int, playerXPosition);
-ZEROPAGE_EXTERN(int, playerYPosition);
+// Which animation sequence (one of the SPRITE_ANIMATION_ types; see spriteAnimationSequences) the player uses while
+// walking. The frames are in the chr file to the right of the player's tiles for each direction.
+#define PLAYER_WALK_ANIMATION SPRITE_ANIMATION_SWAP_FAST
+
+ZEROPAGE_EXTERN(unsigned int, playerXPosition);
+ZEROPAGE_EXTERN(unsigned int, playerYPosition);
 ZEROPAGE_EXTERN(int, playerXVelocity);
 ZEROPAGE_EXTERN(int, playerYVelocity);
 ZEROPAGE_EXTERN(unsigned char, playerDirection);
+// Where the player is in their walking animation, and how long until the next frame. (See STEP_SPRITE_ANIMATION)
+extern unsigned char playerAnimationFrame;
+extern unsigned char playerAnimationTime;
 
 // Helper macro to convert the player's X and Y position into a position on the map
-#define PLAYER_MAP_POSITION(xPos, yPos) (xPos>>4) + (yPos & 0xf0)
+#define PLAYER_MAP_POSITION(xPos, yPos) MAP_POSITION_FROM_PIXELS((unsigned char)((xPos) >> PLAYER_POSITION_SHIFT), (unsigned char)((yPos) >> PLAYER_POSITION_SHIFT))
 
 // Move the player around, and otherwise deal with controller input. (NOTE: Pause/etc are handled here too)
 void handle_player_movement();
@@ -46,8 +66,15 @@ void handle_player_movement();
 // Update the player's sprite, and put it onto the screen as necessary
 void update_player_sprite();
 
-// Tests if the player is about to collide with any solid tiles, and adjusts the player's velocity to zero if found.
+// Moves the player by their velocity, stopping them flush against any solid tiles in the way. Velocity is set to zero
+// in any direction the player was stopped in; the player slides along walls in the other direction.
 void test_player_tile_collision();
 
-// The sprite update method gives us an id of a sprite that we most recently hit. This reacts to that appropriately.
+// Move the player by collisionMove in one direction, stopping at solid tiles. Returns 1 if the player was stopped.
+// Used by test_player_tile_collision; you probably want that instead.
+unsigned char move_player_x();
+unsigned char move_player_y();
+
+// The sprite update method fills in playerSpriteCollisionList with every sprite the player is touching, (and
+// playerSpriteCollisionCount with how many there are) and this walks through that list, reacting to each one.
 void handle_player_sprite_collision();
\ No newline at end of file
@@ -1,27 +1,53 @@
 #include "source/sprites/sprite_definitions.h"
+#include "source/sprites/sprite_scripts.h"
 
 // NOTE: All of this data is in the primary bank.
 
-// Put all newly-designed sprites here. 8 Bytes per sprite, defined mostly from constants
-// in sprite_definitions.h. The 8 bytes are: 
+// Put all newly-designed sprites here. 16 Bytes per sprite, defined mostly from constants
+// in sprite_definitions.h. The 16 bytes are: 
 // 1st byte: Sprite type 
 // 2nd byte: Tile id for first tile, using 8x8 grid. See the guide for more detail on this.
 // 3rd byte: Split; contains sprite size and palette. Combine the constants
 //           using the logical OR operator (represented by the bar character: |) 
+//           Sprites that face left and right can also add SPRITE_FLIP_LEFT here.
 // 4th byte: Animation type
 // 5th byte: How the sprite moves.
 // 6th-8th byte: Miscellaneous; you can use this for whatever extra data you need. For enemies, byte 5
 //           is used as the damage they deal. Health powerups use byte 5 to store how much to restore. 
+//           Sprites with SPRITE_MOVEMENT_SCRIPT use the 6th byte for their script. (A SPRITE_SCRIPT_ id)
+// 9th-12th byte: The box the sprite uses to bump into walls. (Left, top, right, bottom; use one of the
+//           SPRITE_TILE_HITBOX_ constants, or your own numbers.)
+// 13th-16th byte: The box used for touching the player and other sprites. (Use one of the SPRITE_HITBOX_ constants)
 // NOTE: This array cannot contain more than 64 sprites, or other logic will break.
 const unsigned char spriteDefinitions[] = {
-    SPRITE_TYPE_HEALTH, 0xea, SPRITE_SIZE_8PX_8PX | SPRITE_PALETTE_2, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 1, 0x00, 0x00,
-    SPRITE_TYPE_REGULAR_ENEMY, 0x40, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_1, SPRITE_ANIMATION_FULL, SPRITE_MOVEMENT_RANDOM_WANDER, 0x00, 14, 0x01,
-    SPRITE_TYPE_REGULAR_ENEMY, 0x80, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_2, SPRITE_ANIMATION_FULL, SPRITE_MOVEMENT_RANDOM_WANDER, 0x00, 28, 0x02,
-    SPRITE_TYPE_KEY, 0xeb, SPRITE_SIZE_8PX_8PX | SPRITE_PALETTE_2, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00,
-    SPRITE_TYPE_REGULAR_ENEMY, 0xca, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_1, SPRITE_ANIMATION_SWAP, SPRITE_MOVEMENT_LEFT_RIGHT, -60, 0x00, 0x01,
-    SPRITE_TYPE_REGULAR_ENEMY, 0xca, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_3, SPRITE_ANIMATION_SWAP, SPRITE_MOVEMENT_UP_DOWN, -60, 0x00, 0x01,
-    SPRITE_TYPE_DOOR, 0xce, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_0, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00,
-    SPRITE_TYPE_LOCKED_DOOR, 0xc8, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_0, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00,
-    SPRITE_TYPE_ENDGAME, 0xe8, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_1, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00
+    SPRITE_TYPE_HEALTH, 0xea, SPRITE_SIZE_8PX_8PX | SPRITE_PALETTE_2, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 1, 0x00, 0x00, SPRITE_TILE_HITBOX_8PX, SPRITE_HITBOX_8PX,
+    SPRITE_TYPE_REGULAR_ENEMY, 0x40, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_1 | SPRITE_FLIP_LEFT, SPRITE_ANIMATION_FULL, SPRITE_MOVEMENT_RANDOM_WANDER, 0x00, 14, 0x01, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX_SMALL,
+    SPRITE_TYPE_REGULAR_ENEMY, 0x80, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_2 | SPRITE_FLIP_LEFT, SPRITE_ANIMATION_FULL, SPRITE_MOVEMENT_RANDOM_WANDER, 0x00, 28, 0x02, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX_SMALL,
+    SPRITE_TYPE_KEY, 0xeb, SPRITE_SIZE_8PX_8PX | SPRITE_PALETTE_2, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00, SPRITE_TILE_HITBOX_8PX, SPRITE_HITBOX_8PX,
+    SPRITE_TYPE_REGULAR_ENEMY, 0xca, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_1, SPRITE_ANIMATION_SWAP, SPRITE_MOVEMENT_LEFT_RIGHT, -60, 0x00, 0x01, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX_SMALL,
+    SPRITE_TYPE_REGULAR_ENEMY, 0xca, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_3, SPRITE_ANIMATION_SWAP, SPRITE_MOVEMENT_UP_DOWN, -60, 0x00, 0x01, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX_SMALL,
+    SPRITE_TYPE_DOOR, 0xce, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_0, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX,
+    SPRITE_TYPE_LOCKED_DOOR, 0xc8, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_0, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX,
+    SPRITE_TYPE_ENDGAME, 0xe8, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_1, SPRITE_ANIMATION_NONE, SPRITE_MOVEMENT_NONE, 0x00, 0x00, 0x00, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX,
+    SPRITE_TYPE_REGULAR_ENEMY, 0x40, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_3 | SPRITE_FLIP_LEFT, SPRITE_ANIMATION_FULL, SPRITE_MOVEMENT_CHASE, 0x00, 12, 0x01, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX_SMALL,
+    SPRITE_TYPE_REGULAR_ENEMY, 0x80, SPRITE_SIZE_16PX_16PX | SPRITE_PALETTE_3 | SPRITE_FLIP_LEFT, SPRITE_ANIMATION_FULL, SPRITE_MOVEMENT_SCRIPT, SPRITE_SCRIPT_PATROL, 16, 0x01, SPRITE_TILE_HITBOX_16PX, SPRITE_HITBOX_16PX_SMALL
 
+};
+
+// The animation sequence for each animation type, in the same order as the SPRITE_ANIMATION_ ids in
+// sprite_definitions.h. Each frame is 2 bytes:
+// 1st byte: Which frame of the sprite to show. 0 is the tile id from the sprite definition, 1 is the next frame to the
+//           right of it in the chr file, etc. (For 16x16 sprites, each frame is 2 tiles wide)
+// 2nd byte: How many frames (1/60ths of a second) to show it for. (1-255)
+// End each sequence with SPRITE_ANIMATION_LOOP, which starts it over from the top.
+// NOTE: This array cannot be more than 256 bytes long.
+const unsigned char spriteAnimationSequences[] = {
+    // SPRITE_ANIMATION_NONE
+    0, 255, SPRITE_ANIMATION_LOOP,
+    // SPRITE_ANIMATION_SWAP
+    0, 16,  1, 16, SPRITE_ANIMATION_LOOP,
+    // SPRITE_ANIMATION_SWAP_FAST
+    0, 8,   1, 8, SPRITE_ANIMATION_LOOP,
+    // SPRITE_ANIMATION_FULL
+    0, 16,  1, 16, SPRITE_ANIMATION_LOOP
 };
\ No newline at end of file
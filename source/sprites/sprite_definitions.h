@@ -1,8 +1,8 @@
 // We combine size and palette into one byte for sprites, since neither one needs a full byte. (Palette needs 2 bits!)
-// The first 2 bits are used for the palette, and the rest used for the size.
+// The first 2 bits are used for the palette, the next one for SPRITE_FLIP_LEFT, and the rest used for the size.
 // As a result, you have to use a mask to get either value - for example to get size, you have to do `theValue & SPRITE_SIZE_MASK`,
 // or to get the palette, you can use `theValue & SPRITE_PALETTE_MASK`
-#define SPRITE_SIZE_MASK 0x3f
+#define SPRITE_SIZE_MASK 0x1f
 #define SPRITE_SIZE_8PX_8PX 0x00
 #define SPRITE_SIZE_16PX_16PX 0x01
 
@@ -12,14 +12,25 @@
 #define SPRITE_PALETTE_2 0x80
 #define SPRITE_PALETTE_3 0xc0
 
+// Add this to the size/palette byte of a sprite that faces left and right (SPRITE_ANIMATION_FULL) to draw its
+// left-facing frames by mirroring the right-facing ones, instead of using their own tiles. The NES can flip sprites
+// for free, so this frees up the tiles the left-facing frames used to take in sprites.chr.
+#define SPRITE_FLIP_LEFT 0x20
+
+// The animation and movement types are positions in the spriteAnimationHandlers and spriteMovementHandlers tables in
+// map_sprites.c, so they need to count up from 0 with no gaps, in the same order as those tables. Each animation type
+// also has its own sequence of frames in spriteAnimationSequences, in sprite_definitions.c.
+
 // Use this for wprites that are not animated at all.
 #define SPRITE_ANIMATION_NONE 0
 // This is used for sprites with two animation states; it will flip between the two.
-#define SPRITE_ANIMATION_SWAP 10
+#define SPRITE_ANIMATION_SWAP 1
 // This flips sprites between two animation states, like the one above. Just faster!
-#define SPRITE_ANIMATION_SWAP_FAST 11
+#define SPRITE_ANIMATION_SWAP_FAST 2
 // This is the "full" animation style - it flips between two animation frames in each direction.
-#define SPRITE_ANIMATION_FULL 50
+#define SPRITE_ANIMATION_FULL 3
+// How many animation types there are. (One more than the last one)
+#define SPRITE_ANIMATION_COUNT 4
 
 // Use this for sprites that never move.
 #define SPRITE_MOVEMENT_NONE 0
@@ -29,6 +40,14 @@
 #define SPRITE_MOVEMENT_UP_DOWN 2
 // This is used for sprites that wander in a randomized pattern, with collisions.
 #define SPRITE_MOVEMENT_RANDOM_WANDER 3
+// This is used for sprites that walk toward the player, finding their way around walls. (See the flow field in
+// map_sprites.h) They move one tile at a time, so they work best with the SPRITE_TILE_HITBOX_ sizes.
+#define SPRITE_MOVEMENT_CHASE 4
+// This is used for sprites that follow a script from source/sprites/sprite_scripts.txt. Put the script's
+// SPRITE_SCRIPT_ id where the health would go. (See sprite_scripts.h)
+#define SPRITE_MOVEMENT_SCRIPT 5
+// How many movement types there are. (One more than the last one)
+#define SPRITE_MOVEMENT_COUNT 6
 
 // Use _NOTHING for decoration sprites that don't do anything when collided with.
 // This can be used for decorations, etc...
@@ -50,12 +69,17 @@
 // Have to skip over sprite 0 (0x00) and player (0x10)
 #define FIRST_ENEMY_SPRITE_OAM_INDEX 0x20
 
-// How much to shift to get the position on spriteDefinitions. We store 8 bytes, so we shift by 3. 
-// If you want to expand spriteDefinitions to 16 bytes per definition, change this to 4.
-#define SPRITE_DEF_SHIFT 3
+// How much to shift to get the position on spriteDefinitions. We store 16 bytes, so we shift by 4.
+#define SPRITE_DEF_SHIFT 4
+
+// How much to shift sprite positions to put them on the map. Sprite positions work the same way as the player's;
+// the high byte is the pixel on the screen. (See PLAYER_POSITION_SHIFT in player.h)
+#define SPRITE_POSITION_SHIFT 8
 
-// How much to shift sprite positions to put them on the map. 
-#define SPRITE_POSITION_SHIFT 4
+// Do two boxes overlap on one axis? Pass in the position and size of each one. (Positions are unsigned, so a box
+// hanging off the edge of the screen wraps around to the other side; doing the math this way still gives the right
+// answer then. It's also 1 comparison instead of 2.)
+#define RANGES_OVERLAP(posA, sizeA, posB, sizeB) ((unsigned int)((posA) + (sizeA) - (posB) - 1) < (unsigned int)((sizeA) + (sizeB) - 1))
 
 // List of data contained in the sprite definitions array.
 #define SPRITE_DEF_POSITION_TYPE            0
@@ -66,8 +90,65 @@
 #define SPRITE_DEF_POSITION_HP_RESTORE      5
 #define SPRITE_DEF_POSITION_HEALTH          5
 #define SPRITE_DEF_POSITION_SLIDE_SPEED     5
+#define SPRITE_DEF_POSITION_SCRIPT_ID       5
 #define SPRITE_DEF_POSITION_MOVE_SPEED      6
+// The speeds in the sprite definitions are in 16ths of a pixel, so they fit in one byte. load_sprites multiplies them
+// by this to get the same units as sprite positions.
+#define SPRITE_DEF_SPEED_SHIFT 4
 #define SPRITE_DEF_POSITION_DAMAGE          7
+// The box used for bumping into walls: left, top, right, bottom.
+#define SPRITE_DEF_POSITION_TILE_HITBOX_LEFT    8
+#define SPRITE_DEF_POSITION_TILE_HITBOX_TOP     9
+#define SPRITE_DEF_POSITION_TILE_HITBOX_RIGHT   10
+#define SPRITE_DEF_POSITION_TILE_HITBOX_BOTTOM  11
+// The box used for touching the player and other sprites: left, top, right, bottom.
+#define SPRITE_DEF_POSITION_HITBOX_LEFT         12
+#define SPRITE_DEF_POSITION_HITBOX_TOP          13
+#define SPRITE_DEF_POSITION_HITBOX_RIGHT        14
+#define SPRITE_DEF_POSITION_HITBOX_BOTTOM       15
+
+// Hitboxes for the sprite definitions. Each one is 4 bytes: left, top, right, bottom. They're in pixels from the top
+// left corner of the sprite, and the right and bottom are the last pixel inside the box. (So a full 16x16 box is
+// 0, 0, 15, 15) You can use these, or write out your own 4 numbers.
+// NOTE: 8x8 sprites are drawn in the middle of a 16x16 space, (4 pixels in from the top left) so their boxes start at 4.
+
+// Tile hitboxes are what the sprite uses to bump into walls. We make them a pixel smaller than the sprite on each side,
+// so sprites fit through gaps exactly as wide as they are.
+#define SPRITE_TILE_HITBOX_16PX     1, 1, 14, 14
+#define SPRITE_TILE_HITBOX_8PX      4, 4, 11, 11
+// These are for touching the player and other sprites. The whole sprite...
+#define SPRITE_HITBOX_16PX          0, 0, 15, 15
+#define SPRITE_HITBOX_8PX           4, 4, 11, 11
+// ...or a little smaller than it looks, which we use for enemies. Getting hit by something you barely touched feels
+// unfair, so it's better to err on the side of the player.
+#define SPRITE_HITBOX_16PX_SMALL    2, 2, 13, 13
 
 extern const unsigned char spriteDefinitions[];
 
+// Marks the end of an animation sequence in spriteAnimationSequences. (It's a frame that lasts for 0 frames)
+#define SPRITE_ANIMATION_LOOP 0, 0
+
+// The animation sequences for each SPRITE_ANIMATION_ type. See sprite_definitions.c for how they work.
+extern const unsigned char spriteAnimationSequences[];
+
+// Where each animation type's sequence starts in spriteAnimationSequences. Filled in by init_sprite_animations, in
+// map_sprites.c.
+extern unsigned char spriteAnimationSequenceStart[SPRITE_ANIMATION_COUNT];
+
+// Move an animation along by 1 frame. `frame` is the variable holding the position in spriteAnimationSequences, `time`
+// is the one counting down the frames left to show it, and `start` is where the sequence starts. Once this is done,
+// spriteAnimationSequences[frame] is the frame of the sprite to show.
+#define STEP_SPRITE_ANIMATION(frame, time, start) \
+    if (--(time) == 0) { \
+        (frame) += 2; \
+        if (spriteAnimationSequences[(frame) + 1] == 0) { \
+            (frame) = (start); \
+        } \
+        (time) = spriteAnimationSequences[(frame) + 1]; \
+    }
+
+// Start an animation over from the beginning of the sequence at `start`.
+#define START_SPRITE_ANIMATION(frame, time, start) \
+    (frame) = (start); \
+    (time) = spriteAnimationSequences[(frame) + 1];
+
@@ -0,0 +1,47 @@
+// Sprite scripts are little programs that tell a sprite how to move, for sprites using SPRITE_MOVEMENT_SCRIPT. They
+// are written in source/sprites/sprite_scripts.txt, and tools/sprite_script turns them into data when you build.
+// (See tools/sprite_script/README.md for the full list of commands.) Adding a new way for enemies to move this way
+// only costs a few bytes of data, instead of a new movement function in map_sprites.c.
+
+// Generated at build time - defines a SPRITE_SCRIPT_ constant with the id of every script, for sprite_definitions.c.
+#include "temp/sprite_scripts.h"
+
+// The commands scripts are made of. Each one is 1 byte, followed by its arguments, if it has any. These numbers are
+// positions in the spriteScriptCommands table in map_sprites.c, so they need to count up from 0 with no gaps, in the
+// same order as that table. The tool writes these names out, so they need to match the commands in its table too.
+
+// Walk forward for this many turns, or until a wall is in the way. (1 argument: the number of turns, 1-255)
+#define SPRITE_SCRIPT_OP_WALK           0
+// Stand still for this many turns. (1 argument: the number of turns, 1-255)
+#define SPRITE_SCRIPT_OP_WAIT           1
+// Face a direction. (1 argument: a SPRITE_DIRECTION_ value)
+#define SPRITE_SCRIPT_OP_FACE           2
+// Face whichever way gets closest to the player.
+#define SPRITE_SCRIPT_OP_FACE_PLAYER    3
+// Face a random direction.
+#define SPRITE_SCRIPT_OP_FACE_RANDOM    4
+// Face the other way.
+#define SPRITE_SCRIPT_OP_TURN_AROUND    5
+// Carry on from somewhere else in the script. (1 argument: the position in spriteScripts to go to)
+#define SPRITE_SCRIPT_OP_GOTO           6
+// Go somewhere else in the script if a wall is right in front of the sprite. (1 argument: where to go)
+#define SPRITE_SCRIPT_OP_IF_WALL        7
+// Go somewhere else in the script if the player is close by. (2 arguments: how close, in pixels, (1-127) and where
+// to go) "Close" is a square around the sprite, not a circle, since that's much faster to test.
+#define SPRITE_SCRIPT_OP_IF_NEAR        8
+// Put a new sprite on the map, on top of this one and facing the same way. (1 argument: the sprite definition id)
+#define SPRITE_SCRIPT_OP_SPAWN          9
+// Take this sprite off the map.
+#define SPRITE_SCRIPT_OP_REMOVE         10
+// How many commands there are. (One more than the last one)
+#define SPRITE_SCRIPT_OP_COUNT          11
+
+// The most commands a sprite can run in one turn. WALK and WAIT always end the turn; this stops a script made only
+// of the other commands from taking up the whole frame. Whatever's left over runs on the next turn.
+#define SPRITE_SCRIPT_MAX_STEPS 4
+
+// Every script, one after the other. Positions in a script (like the ones GOTO uses) are positions in this array, so
+// all of the scripts together can't be more than 256 bytes. The tool checks this for you.
+extern const unsigned char spriteScripts[];
+// Where each script starts in spriteScripts, by id.
+extern const unsigned char spriteScriptStart[];
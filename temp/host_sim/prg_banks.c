@@ -0,0 +1,14 @@
+const unsigned char PRG_BANK_CREDITS_MENU_NUMBER[1];
+const unsigned char PRG_BANK_ERROR_NUMBER[1];
+const unsigned char PRG_BANK_GAME_OVER_NUMBER[1];
+const unsigned char PRG_BANK_HUD_NUMBER[1];
+const unsigned char PRG_BANK_MAP_LOGIC_NUMBER[1];
+const unsigned char PRG_BANK_MAP_OVERWORLD_NUMBER[1];
+const unsigned char PRG_BANK_MAP_OVERWORLD_PART_0_NUMBER[1];
+const unsigned char PRG_BANK_MAP_OVERWORLD_PART_1_NUMBER[1];
+const unsigned char PRG_BANK_MAP_SPRITES_NUMBER[1];
+const unsigned char PRG_BANK_MENU_INPUT_HELPERS_NUMBER[1];
+const unsigned char PRG_BANK_PAUSE_MENU_NUMBER[1];
+const unsigned char PRG_BANK_PLAYER_SPRITE_NUMBER[1];
+const unsigned char PRG_BANK_SPRITE_SCRIPTS_NUMBER[1];
+const unsigned char PRG_BANK_TITLE_NUMBER[1];
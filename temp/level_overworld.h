@@ -0,0 +1,34 @@
+// This is the data for your entire map, as made available in the .c file of this name
+// The map is 8 rooms wide and 8 rooms tall. A room's id is x + (y * OVERWORLD_WIDTH).
+#define OVERWORLD_WIDTH 8
+#define OVERWORLD_HEIGHT 8
+#define OVERWORLD_ROOM_COUNT 64
+
+// Collision properties for each of the 64 tiles, (TILE_COLLISION_ bits) in the fixed bank.
+extern const unsigned char overworldTileCollision[64];
+
+// Finds the room at playerOverworldPosition in this map, for load_map. In the fixed bank.
+void overworld_find_room();
+
+// The rooms are split up into parts, so they can be spread over several banks. Part 0 is in the
+// PRG_BANK_MAP_OVERWORLD_PART_0 bank, part 1 in PRG_BANK_MAP_OVERWORLD_PART_1, and so on.
+extern const unsigned char overworldPart0[8053];
+extern const unsigned char overworldPart1[4451];
+#define OVERWORLD_PART_COUNT 2
+// The bank a part is in.
+#define OVERWORLD_PART_BANK(part) ((part) == 0 ? PRG_BANK_MAP_OVERWORLD_PART_0 : PRG_BANK_MAP_OVERWORLD_PART_1)
+
+// Everything below is in the PRG_BANK_MAP_OVERWORLD bank.
+// Which part each room is in, and where it starts in that part, by room id. (Each room is the tiles, the number
+// of sprites, then 2 bytes for each sprite, so they aren't all the same length.)
+extern const unsigned char overworldRoomPart[64];
+extern const unsigned int overworldRoomStart[64];
+// Where each part starts.
+extern const unsigned char* const overworldParts[2];
+// The most sprites any room on this map has. (map.h checks that this fits in MAP_MAX_SPRITES)
+#define OVERWORLD_MOST_ROOM_SPRITES 8
+
+// Where each room's sprites start in spritePersistence, (in bits, from the start of this world) and how many bits
+// the whole world needs. Each room gets one bit per sprite it has.
+extern const unsigned int overworldSpritePersistStart[64];
+#define OVERWORLD_SPRITE_PERSIST_BITS 76
@@ -0,0 +1,34 @@
+// This file is generated by tools/bank_packer from the CODE_BANK() calls in the game. Do not edit it!
+// Each PRG bank number is filled in by the linker after it decides where everything goes, so it is only known
+// at link time. That means you can use these anywhere you would use a bank number, except for in a
+// `case` label or an `#if`.
+
+extern const unsigned char PRG_BANK_CREDITS_MENU_NUMBER[];
+extern const unsigned char PRG_BANK_ERROR_NUMBER[];
+extern const unsigned char PRG_BANK_GAME_OVER_NUMBER[];
+extern const unsigned char PRG_BANK_HUD_NUMBER[];
+extern const unsigned char PRG_BANK_MAP_LOGIC_NUMBER[];
+extern const unsigned char PRG_BANK_MAP_OVERWORLD_NUMBER[];
+extern const unsigned char PRG_BANK_MAP_OVERWORLD_PART_0_NUMBER[];
+extern const unsigned char PRG_BANK_MAP_OVERWORLD_PART_1_NUMBER[];
+extern const unsigned char PRG_BANK_MAP_SPRITES_NUMBER[];
+extern const unsigned char PRG_BANK_MENU_INPUT_HELPERS_NUMBER[];
+extern const unsigned char PRG_BANK_PAUSE_MENU_NUMBER[];
+extern const unsigned char PRG_BANK_PLAYER_SPRITE_NUMBER[];
+extern const unsigned char PRG_BANK_SPRITE_SCRIPTS_NUMBER[];
+extern const unsigned char PRG_BANK_TITLE_NUMBER[];
+
+#define PRG_BANK_CREDITS_MENU ((unsigned char)PRG_BANK_CREDITS_MENU_NUMBER)
+#define PRG_BANK_ERROR ((unsigned char)PRG_BANK_ERROR_NUMBER)
+#define PRG_BANK_GAME_OVER ((unsigned char)PRG_BANK_GAME_OVER_NUMBER)
+#define PRG_BANK_HUD ((unsigned char)PRG_BANK_HUD_NUMBER)
+#define PRG_BANK_MAP_LOGIC ((unsigned char)PRG_BANK_MAP_LOGIC_NUMBER)
+#define PRG_BANK_MAP_OVERWORLD ((unsigned char)PRG_BANK_MAP_OVERWORLD_NUMBER)
+#define PRG_BANK_MAP_OVERWORLD_PART_0 ((unsigned char)PRG_BANK_MAP_OVERWORLD_PART_0_NUMBER)
+#define PRG_BANK_MAP_OVERWORLD_PART_1 ((unsigned char)PRG_BANK_MAP_OVERWORLD_PART_1_NUMBER)
+#define PRG_BANK_MAP_SPRITES ((unsigned char)PRG_BANK_MAP_SPRITES_NUMBER)
+#define PRG_BANK_MENU_INPUT_HELPERS ((unsigned char)PRG_BANK_MENU_INPUT_HELPERS_NUMBER)
+#define PRG_BANK_PAUSE_MENU ((unsigned char)PRG_BANK_PAUSE_MENU_NUMBER)
+#define PRG_BANK_PLAYER_SPRITE ((unsigned char)PRG_BANK_PLAYER_SPRITE_NUMBER)
+#define PRG_BANK_SPRITE_SCRIPTS ((unsigned char)PRG_BANK_SPRITE_SCRIPTS_NUMBER)
+#define PRG_BANK_TITLE ((unsigned char)PRG_BANK_TITLE_NUMBER)
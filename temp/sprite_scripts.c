@@ -0,0 +1,27 @@
+// Generated by tools/sprite_script from source/sprites/sprite_scripts.txt. Edit that file instead of this one!
+#include "source/library/bank_helpers.h"
+#include "source/configuration/system_constants.h"
+#include "source/sprites/sprite_scripts.h"
+
+// The scripts get a unit of their own, so they show up on their own in the space check. They have to share a
+// bank with the code that runs them, though; see tools/cc65_config/bank_affinity.json.
+CODE_BANK(PRG_BANK_SPRITE_SCRIPTS);
+
+const unsigned char spriteScripts[21] = {
+    // PATROL (id 0)
+    /* 0 */ SPRITE_SCRIPT_OP_FACE, SPRITE_DIRECTION_RIGHT, // face right
+    /* 2 */ SPRITE_SCRIPT_OP_IF_NEAR, 40, 16, // if_near 40 charge
+    /* 5 */ SPRITE_SCRIPT_OP_IF_WALL, 11, // if_wall turn
+    /* 7 */ SPRITE_SCRIPT_OP_WALK, 8, // walk 8
+    /* 9 */ SPRITE_SCRIPT_OP_GOTO, 2, // goto loop
+    /* 11 */ SPRITE_SCRIPT_OP_TURN_AROUND, // turn_around
+    /* 12 */ SPRITE_SCRIPT_OP_WAIT, 20, // wait 20
+    /* 14 */ SPRITE_SCRIPT_OP_GOTO, 2, // goto loop
+    /* 16 */ SPRITE_SCRIPT_OP_FACE_PLAYER, // face_player
+    /* 17 */ SPRITE_SCRIPT_OP_WALK, 8, // walk 8
+    /* 19 */ SPRITE_SCRIPT_OP_GOTO, 2  // goto loop
+};
+
+const unsigned char spriteScriptStart[1] = {
+    0
+};
@@ -0,0 +1,6 @@
+// Generated by tools/sprite_script from source/sprites/sprite_scripts.txt. The id of each script, for sprite_definitions.c.
+
+#define SPRITE_SCRIPT_PATROL 0
+
+// How many scripts there are.
+#define SPRITE_SCRIPT_COUNT 1
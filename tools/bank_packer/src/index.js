@@ -0,0 +1,479 @@
+/**
+ * Decides which PRG bank every piece of banked code and data goes into, so you don't have to.
+ *
+ * C files say which "unit" they belong to with `CODE_BANK(PRG_BANK_SOMETHING)`. Every unit gets its own segment, and
+ * this tool works out how big each one is, then packs them into ROM_00 through ROM_06. Units that call each other a
+ * lot (listed in tools/cc65_config/bank_affinity.json) are kept in the same bank where possible, since switching
+ * banks is slow, and the bank helpers skip the switch entirely if you're already in the right bank.
+ *
+ * The bank numbers themselves are given to the code as linker symbols, so nothing has to be recompiled when the
+ * packing changes - only relinked. It runs in three steps, all driven by the makefile:
+ *
+ *  1. header: Scan the C files for CODE_BANK() and write out temp/prg_banks.h, which defines every PRG_BANK_ constant.
+ *  2. sizing: Write a linker config that gives every unit its own huge bank, so a test link can tell us their sizes.
+ *  3. pack:   Read those sizes from the test link's map file, pack the units into banks, and write the real config.
+ *
+ * This tool has no dependencies outside of nodejs itself, so it can run anywhere node can.
+ */
+var VERSION = require('./package.json').version;
+
+var fs = require('fs'),
+    logLevel = 'info', // change to 'verbose' for some extra output
+    command = process.argv[2],
+    // Suffix added to each unit's name to get the linker symbol holding its bank number.
+    BANK_NUMBER_SUFFIX = '_NUMBER',
+    // Markers in the linker config template, which we replace with generated lines.
+    MEMORY_MARKER = '# BANK_PACKER_MEMORY',
+    SEGMENTS_MARKER = '# BANK_PACKER_SEGMENTS',
+    SYMBOLS_MARKER = '# BANK_PACKER_SYMBOLS',
+    // Matches the switchable banks in the linker config. (ROM_00, ROM_01, etc)
+    BANK_AREA_REGEX = /^ROM_([0-9A-Fa-f]{2})$/,
+    // Matches a CODE_BANK() call in C, capturing the unit name.
+    CODE_BANK_REGEX = /^\s*CODE_BANK\s*\(\s*([A-Za-z0-9_]+)\s*\)/gm;
+
+function printDate() {
+    return '[' + new Date().toUTCString() + '] ';
+}
+
+function printUsage() {
+    out('bank_packer version ' + VERSION);
+    out('Usage: bank_packer header [path/to/prg_banks.h] [c files...]');
+    out('       bank_packer sizing [path/to/game.cfg] [path/to/prg_banks.h] [path/to/sizing.cfg]');
+    out('       bank_packer pack [path/to/game.cfg] [path/to/prg_banks.h] [path/to/bank_affinity.json] [path/to/sizing.map] [path/to/output.cfg]');
+}
+
+function out() {
+    var args = [].slice.call(arguments);
+    args.unshift('[bank_packer] ', printDate());
+
+    console.info.apply(this, args);
+}
+
+function verbose() {
+    var args = [].slice.call(arguments);
+    args.unshift('[bank_packer] ', printDate());
+
+    if (logLevel == 'verbose') {
+        console.info.apply(this, args);
+    }
+}
+
+function fail(message) {
+    out('ERROR: ' + message);
+    process.exit(1);
+}
+
+// ld65 config values can be written as $hex, 0xhex, or decimal.
+function parseNumber(str) {
+    str = str.trim();
+    if (str.indexOf('$') === 0) {
+        return parseInt(str.substr(1), 16);
+    } else if (str.indexOf('0x') === 0) {
+        return parseInt(str.substr(2), 16);
+    }
+    return parseInt(str, 10);
+}
+
+function padRight(str, len) {
+    str = String(str);
+    while (str.length < len) {
+        str += ' ';
+    }
+    return str;
+}
+
+function padLeft(str, len) {
+    str = String(str);
+    while (str.length < len) {
+        str = ' ' + str;
+    }
+    return str;
+}
+
+// Only write files when they actually change, so make doesn't rebuild everything that depends on them.
+function writeIfChanged(fileName, contents) {
+    if (fs.existsSync(fileName) && fs.readFileSync(fileName).toString() == contents) {
+        verbose(fileName + ' is unchanged; not rewriting it.');
+        return;
+    }
+    fs.writeFileSync(fileName, contents);
+}
+
+// Pulls a block like `MEMORY { ... }` out of the linker config, and turns every `NAME: a = b, c = d;` line into
+// an object of {a: 'b', c: 'd'}, keyed by name.
+function parseConfigBlock(configText, blockName) {
+    configText = configText.replace(/#.*$/gm, '');
+    var blockStart = configText.search(new RegExp('\\b' + blockName + '\\s*\\{')),
+        entries = {};
+    if (blockStart === -1) {
+        return entries;
+    }
+    var blockText = configText.substr(configText.indexOf('{', blockStart) + 1);
+    blockText = blockText.substr(0, blockText.indexOf('}'));
+
+    blockText.split(';').forEach(function(line) {
+        var nameMatch = line.match(/^\s*([A-Za-z0-9_]+)\s*:([\s\S]*)$/);
+        if (!nameMatch) {
+            return;
+        }
+        var attributes = {};
+        nameMatch[2].split(',').forEach(function(attr) {
+            var parts = attr.split('=');
+            if (parts.length == 2) {
+                attributes[parts[0].trim()] = parts[1].trim();
+            }
+        });
+        entries[nameMatch[1]] = attributes;
+    });
+    return entries;
+}
+
+// Reads the "Segment list" section of an ld65 map file, and returns a map of segment name to size.
+function parseMapSegmentSizes(mapText) {
+    var inSegmentList = false,
+        sizes = {};
+    mapText.split(/\r?\n/).forEach(function(line) {
+        if (line.indexOf('Segment list:') === 0) {
+            inSegmentList = true;
+            return;
+        } else if (/^[A-Za-z].* list/.test(line)) {
+            inSegmentList = false;
+            return;
+        }
+        // Name                   Start     End    Size  Align
+        var match = inSegmentList && line.match(/^([A-Za-z0-9_]+)\s+([0-9A-Fa-f]{6})\s+([0-9A-Fa-f]{6})\s+([0-9A-Fa-f]{6})/);
+        if (match) {
+            sizes[match[1]] = parseInt(match[4], 16);
+        }
+    });
+    return sizes;
+}
+
+// Reads the list of units back out of the header we generated in step 1.
+function readUnits(headerFile) {
+    var units = [],
+        regex = /^#define\s+([A-Za-z0-9_]+)\s/gm,
+        match;
+    var headerText = fs.readFileSync(headerFile).toString();
+    while ((match = regex.exec(headerText)) !== null) {
+        units.push(match[1]);
+    }
+    return units;
+}
+
+// Swaps a marker comment in the config template out for some generated lines.
+function replaceMarker(configText, marker, lines) {
+    if (configText.indexOf(marker) === -1) {
+        fail('Could not find "' + marker + '" in the linker config. Did it get removed?');
+    }
+    return configText.replace(marker, marker + '\n' + lines.join('\n'));
+}
+
+// Figures out how much space each switchable bank has for packed units, after taking out anything that is already
+// put there by hand. (Like the music in ROM_00, and the reset stubs at the end of every bank.)
+function getBanks(configText, segmentSizes) {
+    var memoryAreas = parseConfigBlock(configText, 'MEMORY'),
+        segments = parseConfigBlock(configText, 'SEGMENTS'),
+        banks = [];
+
+    Object.keys(memoryAreas).forEach(function(areaName) {
+        var match = areaName.match(BANK_AREA_REGEX);
+        if (!match) {
+            return;
+        }
+        var start = parseNumber(memoryAreas[areaName].start),
+            end = start + parseNumber(memoryAreas[areaName].size),
+            used = 0;
+
+        Object.keys(segments).forEach(function(segmentName) {
+            if (segments[segmentName].load != areaName) {
+                return;
+            }
+            // Segments with a fixed start address (like the reset stubs) cut off the end of the bank. Everything else
+            // is placed before our units, so it just uses up space.
+            if (segments[segmentName].start) {
+                end = Math.min(end, parseNumber(segments[segmentName].start));
+            } else {
+                used += segmentSizes[segmentName] || 0;
+            }
+        });
+
+        banks.push({name: areaName, number: parseInt(match[1], 16), capacity: end - start - used, used: 0, units: []});
+    });
+    return banks.sort(function(a, b) { return a.number - b.number; });
+}
+
+// Our config file is json, but we let people put full-line `//` comments in it, since it's meant to be edited by hand.
+function readAffinityConfig(fileName) {
+    var text = fs.readFileSync(fileName).toString().replace(/^\s*\/\/.*$/gm, ''),
+        config;
+    try {
+        config = JSON.parse(text);
+    } catch (e) {
+        fail('Could not parse ' + fileName + ': ' + e.message);
+    }
+    config.together = config.together || [];
+    config.pinned = config.pinned || {};
+    config.affinity = config.affinity || [];
+    return config;
+}
+
+// Step 1: find every unit, and write a header that defines a PRG_BANK_ constant for each.
+function writeHeader(headerFile, sourceFiles) {
+    var units = {};
+    sourceFiles.forEach(function(fileName) {
+        var text = fs.readFileSync(fileName).toString(),
+            match;
+        CODE_BANK_REGEX.lastIndex = 0;
+        while ((match = CODE_BANK_REGEX.exec(text)) !== null) {
+            if (/^[0-9]/.test(match[1])) {
+                fail(fileName + ' uses CODE_BANK(' + match[1] + '). Banks are now picked automatically; give the code a ' +
+                    'name instead, like CODE_BANK(PRG_BANK_MY_CODE). If it really must be in bank ' + match[1] + ', pin ' +
+                    'it in tools/cc65_config/bank_affinity.json.');
+            }
+            units[match[1]] = true;
+        }
+    });
+
+    var unitNames = Object.keys(units).sort(),
+        headerText = '// This file is generated by tools/bank_packer from the CODE_BANK() calls in the game. Do not edit it!\n' +
+            '// Each PRG bank number is filled in by the linker after it decides where everything goes, so it is only known\n' +
+            '// at link time. That means you can use these anywhere you would use a bank number, except for in a\n' +
+            '// `case` label or an `#if`.\n\n';
+    unitNames.forEach(function(unit) {
+        headerText += 'extern const unsigned char ' + unit + BANK_NUMBER_SUFFIX + '[];\n';
+    });
+    headerText += '\n';
+    unitNames.forEach(function(unit) {
+        headerText += '#define ' + unit + ' ((unsigned char)' + unit + BANK_NUMBER_SUFFIX + ')\n';
+    });
+
+    writeIfChanged(headerFile, headerText);
+    out('Found ' + unitNames.length + ' banked units in ' + sourceFiles.length + ' files.');
+}
+
+// Step 2: write a config that puts every unit in its own area, so a test link can measure them all.
+function writeSizingConfig(configFile, headerFile, outputFile) {
+    var configText = fs.readFileSync(configFile).toString(),
+        units = readUnits(headerFile),
+        memoryLines = [],
+        segmentLines = [],
+        symbolLines = [];
+
+    units.forEach(function(unit) {
+        // These areas are much bigger than a real bank, so that the test link still works when a unit is too big.
+        memoryLines.push('    SIZE_' + unit + ': start = $8000, size = $7000, file = "";');
+        segmentLines.push('    ' + unit + ': load = SIZE_' + unit + ', type = ro, define = no;');
+        symbolLines.push('    _' + unit + BANK_NUMBER_SUFFIX + ' = 0;');
+    });
+
+    configText = replaceMarker(configText, MEMORY_MARKER, memoryLines);
+    configText = replaceMarker(configText, SEGMENTS_MARKER, segmentLines);
+    configText = replaceMarker(configText, SYMBOLS_MARKER, symbolLines);
+    writeIfChanged(outputFile, configText);
+}
+
+// Puts a group of units into a bank, and keeps the bank's totals up to date.
+function placeGroup(bank, group, placements) {
+    group.units.forEach(function(unit) {
+        bank.units.push(unit);
+        placements[unit] = bank;
+    });
+    bank.used += group.size;
+}
+
+// How much we like putting this group into this bank: the total affinity weight to everything already in there.
+function affinityScore(bank, group, affinityPairs) {
+    var score = 0;
+    affinityPairs.forEach(function(pair) {
+        var aInGroup = group.units.indexOf(pair.a) !== -1,
+            bInGroup = group.units.indexOf(pair.b) !== -1;
+        if ((aInGroup && bank.units.indexOf(pair.b) !== -1) || (bInGroup && bank.units.indexOf(pair.a) !== -1)) {
+            score += pair.weight;
+        }
+    });
+    return score;
+}
+
+// Try to fit every group into a bank. Pinned groups go first, then the rest from largest to smallest. Each group goes
+// into the bank it has the most affinity with; if that's a tie, the fullest bank it fits into. (This keeps big empty
+// banks free for big units that come later.) Returns null if something didn't fit.
+function packGroups(groups, banks, affinityPairs) {
+    var placements = {};
+    banks.forEach(function(bank) {
+        bank.used = 0;
+        bank.units = [];
+    });
+
+    var ordered = groups.slice().sort(function(a, b) {
+        if ((a.pinned !== null) != (b.pinned !== null)) {
+            return a.pinned !== null ? -1 : 1;
+        }
+        return b.size - a.size || (a.units[0] < b.units[0] ? -1 : 1);
+    });
+
+    for (var i = 0; i < ordered.length; i++) {
+        var group = ordered[i],
+            bestBank = null,
+            bestScore = -1;
+        banks.forEach(function(bank) {
+            if (bank.capacity - bank.used < group.size || (group.pinned !== null && bank.number != group.pinned)) {
+                return;
+            }
+            var score = affinityScore(bank, group, affinityPairs);
+            if (score > bestScore || (score == bestScore && bank.capacity - bank.used < bestBank.capacity - bestBank.used)) {
+                bestBank = bank;
+                bestScore = score;
+            }
+        });
+        if (!bestBank) {
+            verbose('Could not fit group [' + group.units.join(', ') + '] (' + group.size + ' bytes) anywhere.');
+            return null;
+        }
+        placeGroup(bestBank, group, placements);
+    }
+    return placements;
+}
+
+// Merge two groups into one, if they're allowed to live in the same bank.
+function mergeGroups(groups, a, b) {
+    if (a.pinned !== null && b.pinned !== null && a.pinned != b.pinned) {
+        return false;
+    }
+    a.units = a.units.concat(b.units);
+    a.size += b.size;
+    a.pinned = a.pinned !== null ? a.pinned : b.pinned;
+    groups.splice(groups.indexOf(b), 1);
+    return true;
+}
+
+function findGroup(groups, unit) {
+    for (var i = 0; i < groups.length; i++) {
+        if (groups[i].units.indexOf(unit) !== -1) {
+            return groups[i];
+        }
+    }
+    return null;
+}
+
+// Builds the list of groups to pack. Units listed as `together` always share a bank. If `useAffinity` is set, we also
+// glue together the pairs with the highest affinity first, as long as the result still fits in a bank.
+function buildGroups(units, sizes, config, affinityPairs, banks, useAffinity) {
+    var groups = units.map(function(unit) {
+        var pinned = config.pinned[unit] !== undefined ? parseInt(config.pinned[unit], 10) : null;
+        return {units: [unit], size: sizes[unit] || 0, pinned: pinned};
+    });
+
+    config.together.forEach(function(list) {
+        for (var i = 1; i < list.length; i++) {
+            var a = findGroup(groups, list[0]),
+                b = findGroup(groups, list[i]);
+            if (a && b && a !== b && !mergeGroups(groups, a, b)) {
+                fail(list[0] + ' and ' + list[i] + ' must be in the same bank, but they are pinned to different banks.');
+            }
+        }
+    });
+
+    if (useAffinity) {
+        var biggestBank = Math.max.apply(Math, banks.map(function(bank) { return bank.capacity; }));
+        affinityPairs.forEach(function(pair) {
+            var a = findGroup(groups, pair.a),
+                b = findGroup(groups, pair.b);
+            if (a && b && a !== b && a.size + b.size <= biggestBank) {
+                mergeGroups(groups, a, b);
+            }
+        });
+    }
+    return groups;
+}
+
+// Step 3: pack the units into banks, and write the real linker config.
+function pack(configFile, headerFile, affinityFile, mapFile, outputFile) {
+    var configText = fs.readFileSync(configFile).toString(),
+        units = readUnits(headerFile),
+        config = readAffinityConfig(affinityFile),
+        sizes = parseMapSegmentSizes(fs.readFileSync(mapFile).toString()),
+        banks = getBanks(configText, sizes),
+        affinityPairs = [];
+
+    // Expand the affinity list into pairs, heaviest first. Anything naming a unit we don't have is probably a typo.
+    config.affinity.forEach(function(entry) {
+        for (var i = 0; i < entry.units.length; i++) {
+            if (units.indexOf(entry.units[i]) === -1) {
+                out('WARNING: ' + affinityFile + ' mentions ' + entry.units[i] + ', but no code uses CODE_BANK(' + entry.units[i] + ').');
+            }
+            for (var j = i + 1; j < entry.units.length; j++) {
+                affinityPairs.push({a: entry.units[i], b: entry.units[j], weight: entry.weight || 1});
+            }
+        }
+    });
+    affinityPairs.sort(function(a, b) { return b.weight - a.weight; });
+
+    units.forEach(function(unit) {
+        if (sizes[unit] === undefined) {
+            verbose(unit + ' was not in the map file; assuming it is empty.');
+        }
+    });
+
+    // First try with the hot pairs glued together. If that doesn't fit, fall back to only the required groups, and let
+    // the affinity scores do what they can while packing.
+    var groups = buildGroups(units, sizes, config, affinityPairs, banks, true),
+        placements = packGroups(groups, banks, affinityPairs);
+    if (!placements) {
+        verbose('Packing with affinity groups failed; trying again without them.');
+        groups = buildGroups(units, sizes, config, affinityPairs, banks, false);
+        placements = packGroups(groups, banks, affinityPairs);
+    }
+    if (!placements) {
+        var biggestBank = Math.max.apply(Math, banks.map(function(bank) { return bank.capacity; }));
+        groups.forEach(function(group) {
+            if (group.size > biggestBank) {
+                out('ERROR: [' + group.units.join(', ') + '] needs ' + group.size + ' bytes, but the biggest bank only has room for ' + biggestBank + '.');
+            }
+        });
+        var total =units.reduce(function(sum, unit) { return sum + (sizes[unit] || 0); }, 0);
+        fail('Could not fit all banked code and data into the PRG banks. (' + total + ' bytes to place) Try splitting ' +
+            'some large units up, or removing some `together` groups from ' + affinityFile + '.');
+    }
+
+    var segmentLines = [],
+        symbolLines = [];
+    // Keep the same order as the header, so the config doesn't change for no reason.
+    units.forEach(function(unit) {
+        segmentLines.push('    ' + padRight(unit + ':', 32) + 'load = ' + placements[unit].name + ', type = ro, define = no;');
+        symbolLines.push('    _' + unit + BANK_NUMBER_SUFFIX + ' = ' + placements[unit].number + ';');
+    });
+
+    configText = replaceMarker(configText, MEMORY_MARKER, []);
+    configText = replaceMarker(configText, SEGMENTS_MARKER, segmentLines);
+    configText = replaceMarker(configText, SYMBOLS_MARKER, symbolLines);
+    writeIfChanged(outputFile, configText);
+
+    // Tell the user where everything went, and which hot pairs we had to split up.
+    console.info('');
+    console.info('===== Bank packing =====');
+    banks.forEach(function(bank) {
+        console.info(padRight(bank.name, 8) + padLeft(bank.used, 6) + ' / ' + padLeft(bank.capacity, 5) + ' bytes  ' +
+            (bank.units.length ? bank.units.join(', ') : '(empty)'));
+    });
+    var splitWeight = 0;
+    affinityPairs.forEach(function(pair) {
+        if (placements[pair.a] && placements[pair.b] && placements[pair.a] !== placements[pair.b]) {
+            out('NOTE: ' + pair.a + ' and ' + pair.b + ' (weight ' + pair.weight + ') ended up in different banks.');
+            splitWeight += pair.weight;
+        }
+    });
+    console.info('');
+    out('Packed ' + units.length + ' units. Affinity weight lost to bank switches: ' + splitWeight + '.');
+}
+
+if (command == 'header' && process.argv.length >= 4) {
+    writeHeader(process.argv[3], process.argv.slice(4));
+} else if (command == 'sizing' && process.argv.length == 6) {
+    writeSizingConfig(process.argv[3], process.argv[4], process.argv[5]);
+} else if (command == 'pack' && process.argv.length == 8) {
+    pack(process.argv[3], process.argv[4], process.argv[5], process.argv[6], process.argv[7]);
+} else {
+    printUsage();
+    process.exit(1);
+}
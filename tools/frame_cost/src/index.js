@@ -0,0 +1,485 @@
+/**
+ * Finds the slowest rooms in the game. Boots the rom in a small headless emulator (see nes.js) once per cpu core,
+ * and has each one visit rooms on the overworld: the player is dropped into the room by setting
+ * playerOverworldPosition, (the game's own screen transition does the loading) then wanders around with random input
+ * for a few thousand frames. Every trip through the main loop is timed, from the moment ppu_wait_frame returns to
+ * the moment it's called again.
+ *
+ * At the end, it prints a table with the worst, 99th percentile and average frame cost for every room, and how many
+ * frames ran long enough to miss a vblank. (lag frames) Slowest rooms come first.
+ *
+ * This tool has no dependencies outside of nodejs itself, so it can run anywhere node can.
+ */
+var VERSION = require('./package.json').version;
+
+var fs = require('fs'),
+    os = require('os'),
+    path = require('path'),
+    childProcess = require('child_process'),
+    Nes = require('./nes.js'),
+    logLevel = 'info', // change to 'verbose' for some extra output
+
+    // These mirror source/configuration/game_states.h and system_constants.h; keep them in sync if you change those.
+    GAME_STATE_TITLE_INPUT = 11,
+    GAME_STATE_RUNNING = 50,
+    GAME_STATE_SCREEN_SCROLL = 150,
+    SPRITE_DIRECTION_STATIONARY = 0x02,
+    PAD_A = 0x01,
+    PAD_START = 0x08,
+    PAD_UP = 0x10,
+    PAD_DOWN = 0x20,
+    PAD_LEFT = 0x40,
+    PAD_RIGHT = 0x80,
+    // tmx2c writes the size of the overworld into this header. (OVERWORLD_WIDTH and OVERWORLD_ROOM_COUNT)
+    DEFAULT_MAP_HEADER = 'temp/level_overworld.h',
+    // How many rooms the overworld has, and how many rooms wide it is. Read from the map header by readWorldSize.
+    roomCount = 64,
+    roomsWide = 8,
+
+    // Every symbol from the game we need to find in the map file.
+    SYMBOLS = ['_gameState', '_playerOverworldPosition', '_playerDirection', '_playerHealth', '_playerMaxHealth', '_ppu_wait_frame'],
+    // If the game hasn't made it from power on to the first room after this many frames, something is wrong.
+    BOOT_FRAME_LIMIT = 3000,
+    // How long it takes to get from one room to another, at most. (With a fade out and in; used to detect hangs)
+    TRANSITION_FRAME_LIMIT = 600;
+
+function printDate() {
+    return '[' + new Date().toUTCString() + '] ';
+}
+
+function printUsage() {
+    out('frame_cost version ' + VERSION);
+    out('Usage: frame_cost [path/to/rom.nes] [path/to/rom.map] [options]');
+    out('Options:');
+    out('  --frames N     How many frames to time in each room. (Default: 3000)');
+    out('  --rooms LIST   Which rooms to visit, for example 0-7,12,20. (Default: all of them)');
+    out('  --seed N       Seed for the random input. The same seed always gives the same results. (Default: 1)');
+    out('  --workers N    How many emulators to run at once. (Default: one per cpu core)');
+    out('  --json FILE    Also write the results to FILE as json.');
+    out('  --map-header FILE  The header tmx2c wrote for the overworld, to get its size from. (Default: ' + DEFAULT_MAP_HEADER + ')');
+}
+
+function out() {
+    var args = [].slice.call(arguments);
+    args.unshift('[frame_cost] ', printDate());
+
+    console.info.apply(this, args);
+}
+
+function verbose() {
+    var args = [].slice.call(arguments);
+    args.unshift('[frame_cost] ', printDate());
+
+    if (logLevel == 'verbose') {
+        console.info.apply(this, args);
+    }
+}
+
+function padLeft(str, len) {
+    str = String(str);
+    while (str.length < len) {
+        str = ' ' + str;
+    }
+    return str;
+}
+
+// Reads the "Exports list" out of the ld65 map file. Every non-static variable and function in the game shows up
+// there, with its address.
+function parseSymbols(mapText) {
+    var symbols = {},
+        exportsStart = mapText.indexOf('Exports list by name:');
+    if (exportsStart === -1) {
+        throw new Error('The map file has no exports list. Was it written by ld65?');
+    }
+    // The list ends at the first blank line.
+    var exportsText = mapText.substr(exportsStart).replace(/\r/g, '').split('\n\n')[0];
+    exportsText.replace(/(\S+)\s+([0-9A-Fa-f]{6})\s+[A-Z]+/g, function(all, name, value) {
+        symbols[name] = parseInt(value, 16);
+    });
+
+    SYMBOLS.forEach(function(name) {
+        if (symbols[name] === undefined) {
+            throw new Error('Could not find ' + name + ' in the map file.');
+        }
+    });
+    return symbols;
+}
+
+// Reads how big the overworld is out of the header tmx2c writes for it.
+function readWorldSize(headerFile) {
+    var headerText = fs.readFileSync(headerFile, 'utf8'),
+        countMatch = headerText.match(/^#define OVERWORLD_ROOM_COUNT ([0-9]+)/m),
+        widthMatch = headerText.match(/^#define OVERWORLD_WIDTH ([0-9]+)/m);
+    if (!countMatch || !widthMatch) {
+        throw new Error('Could not find the size of the overworld in ' + headerFile + '. Was it written by tmx2c?');
+    }
+    roomCount = parseInt(countMatch[1], 10);
+    roomsWide = parseInt(widthMatch[1], 10);
+}
+
+// Turns "0-7,12,20" into [0, 1, ..., 7, 12, 20].
+function parseRooms(str) {
+    var rooms = [];
+    str.split(',').forEach(function(part) {
+        var range = part.split('-').map(function(num) { return parseInt(num, 10); }),
+            last = range.length > 1 ? range[1] : range[0];
+        for (var room = range[0]; room <= last; room++) {
+            if (isNaN(room) || room < 0 || room >= roomCount) {
+                throw new Error('Bad room number in "' + str + '". Rooms go from 0 to ' + (roomCount - 1) + '.');
+            }
+            rooms.push(room);
+        }
+    });
+    return rooms;
+}
+
+// ===== Running the game (this part runs in the worker processes) =====
+
+// A tiny random number generator, so the input is the same on every run, and on every computer. (xorshift32)
+function Random(seed) {
+    this.state = (seed >>> 0) || 1;
+}
+
+Random.prototype.next = function() {
+    var x = this.state;
+    x ^= x << 13;
+    x ^= x >>> 17;
+    x ^= x << 5;
+    this.state = x >>> 0;
+    return this.state;
+};
+
+// Random input that looks a bit like a person playing: walk in a direction for a while, sometimes diagonally, and
+// press A now and then. Start and select are never pressed, so the game never pauses.
+function RandomInput(seed) {
+    this.random = new Random(seed);
+    this.buttons = 0;
+    this.framesLeft = 0;
+}
+
+RandomInput.prototype.nextFrame = function() {
+    var directions = [PAD_UP, PAD_DOWN, PAD_LEFT, PAD_RIGHT, 0];
+    if (this.framesLeft-- <= 0) {
+        this.buttons = directions[this.random.next() % directions.length];
+        if (this.random.next() % 4 === 0) {
+            this.buttons |= directions[this.random.next() % 4];
+        }
+        this.framesLeft = 8 + (this.random.next() % 40);
+    }
+    return this.buttons | (this.random.next() % 16 === 0 ? PAD_A : 0);
+};
+
+/**
+ * Wraps the emulator with the bits needed to drive the game: finding the main loop, teleporting between rooms, and
+ * timing each frame.
+ */
+function GameRunner(romData, symbols) {
+    this.nes = new Nes(romData);
+    this.symbols = symbols;
+    this.input = null;
+    this.lastInputFrame = -1;
+}
+
+// Runs the emulator until the game's main loop calls ppu_wait_frame, then until it returns. Returns how many cycles
+// the game's own code took before the call, (the work for that frame) how many the nmi handler took over the whole
+// frame, and whether an nmi happened in the middle of the work. (A lag frame)
+GameRunner.prototype.runMainLoopFrame = function(nmiLimit) {
+    var nes = this.nes,
+        waitFrame = this.symbols._ppu_wait_frame,
+        startCycles = nes.cycles,
+        startNmiCycles = nes.nmiCycles,
+        startNmiCount = nes.nmiCount;
+
+    while (nes.pc !== waitFrame || nes.nmiDepth) {
+        this.stepWithInput();
+        if (nes.nmiCount - startNmiCount > nmiLimit) {
+            return null;
+        }
+    }
+    // Time spent in the nmi handler doesn't belong to the game logic, so it's taken out and reported on its own.
+    var frame = {
+        cycles: (nes.cycles - startCycles) - (nes.nmiCycles - startNmiCycles),
+        nmiCycles: 0,
+        lag: nes.nmiCount !== startNmiCount
+    };
+
+    // The return address is on top of the stack; once we get back there with the stack popped, the call is done.
+    var stackPointer = nes.sp,
+        returnAddress = ((nes.ram[0x100 | ((stackPointer + 1) & 0xff)] | (nes.ram[0x100 | ((stackPointer + 2) & 0xff)] << 8)) + 1) & 0xffff;
+    do {
+        this.stepWithInput();
+        if (nes.nmiCount - startNmiCount > nmiLimit) {
+            return null;
+        }
+    } while (nes.pc !== returnAddress || nes.sp !== ((stackPointer + 2) & 0xff) || nes.nmiDepth);
+    frame.nmiCycles = nes.nmiCycles - startNmiCycles;
+    return frame;
+};
+
+// Runs one instruction, changing the buttons held on the controller once per frame.
+GameRunner.prototype.stepWithInput = function() {
+    if (this.nes.nmiCount !== this.lastInputFrame) {
+        this.lastInputFrame = this.nes.nmiCount;
+        this.nes.buttons = this.input ? this.input(this.nes.nmiCount) : 0;
+    }
+    this.nes.step();
+};
+
+GameRunner.prototype.peek = function(name) {
+    return this.nes.ram[this.symbols[name]];
+};
+
+GameRunner.prototype.poke = function(name, value) {
+    this.nes.ram[this.symbols[name]] = value;
+};
+
+// Turns on the console and gets through the title screen, leaving the game at the end of its first frame of
+// gameplay. A snapshot of that moment is what every room starts from.
+GameRunner.prototype.boot = function() {
+    var runner = this;
+    this.nes.reset();
+    this.input = function(frame) {
+        // Tap start on the title screen, until the game notices.
+        return (runner.peek('_gameState') === GAME_STATE_TITLE_INPUT && (frame & 8)) ? PAD_START : 0;
+    };
+    for (var frames = 0; frames < BOOT_FRAME_LIMIT; frames++) {
+        if (!this.runMainLoopFrame(BOOT_FRAME_LIMIT)) {
+            break;
+        }
+        if (this.peek('_gameState') === GAME_STATE_RUNNING) {
+            this.bootState = this.nes.snapshot();
+            return;
+        }
+    }
+    throw new Error('The game never made it from the title screen to the first room.');
+};
+
+// Puts the player into the given room, and waits for the screen transition to finish.
+GameRunner.prototype.teleport = function(room) {
+    this.poke('_playerOverworldPosition', room);
+    // Any direction other than left/right/up/down keeps the player where they are, instead of moving them to the
+    // edge of the screen they came in from.
+    this.poke('_playerDirection', SPRITE_DIRECTION_STATIONARY);
+    this.poke('_gameState', GAME_STATE_SCREEN_SCROLL);
+    for (var frames = 0; frames < TRANSITION_FRAME_LIMIT; frames++) {
+        if (!this.runMainLoopFrame(TRANSITION_FRAME_LIMIT)) {
+            break;
+        }
+        if (this.peek('_gameState') === GAME_STATE_RUNNING) {
+            return;
+        }
+    }
+    throw new Error('The game got stuck going into room ' + room + '.');
+};
+
+/**
+ * Times the given number of frames in one room. Health is topped up every frame, so the player never dies. If the
+ * player walks out of the room, or anything else takes the game out of its normal running state, they get put back.
+ * Only frames that start and end in the room, in the running state, are counted.
+ */
+GameRunner.prototype.measureRoom = function(room, frameCount, seed) {
+    var randomInput = new RandomInput(seed * 7919 + room + 1),
+        samples = [],
+        nmiSamples = [],
+        lagFrames = 0,
+        resets = 0;
+
+    this.nes.restore(this.bootState);
+    this.input = null;
+    this.teleport(room);
+    this.input = function() { return randomInput.nextFrame(); };
+
+    while (samples.length < frameCount) {
+        this.poke('_playerHealth', this.peek('_playerMaxHealth'));
+        var frame = this.runMainLoopFrame(TRANSITION_FRAME_LIMIT);
+        if (!frame) {
+            throw new Error('The game stopped running its main loop in room ' + room + '.');
+        }
+
+        var state = this.peek('_gameState');
+        if (state === GAME_STATE_RUNNING && this.peek('_playerOverworldPosition') === room) {
+            samples.push(frame.cycles);
+            nmiSamples.push(frame.nmiCycles);
+            if (frame.lag) {
+                lagFrames++;
+            }
+        } else if (state !== GAME_STATE_SCREEN_SCROLL) {
+            // Paused, won, lost... start over from the beginning.
+            verbose('Room ' + room + ' left the running state (' + state + '); starting it over.');
+            this.nes.restore(this.bootState);
+            this.input = null;
+            this.teleport(room);
+            this.input = function() { return randomInput.nextFrame(); };
+            resets++;
+        } else {
+            // Walked out of the room. The frame that started the transition still counts; then bring them back.
+            samples.push(frame.cycles);
+            nmiSamples.push(frame.nmiCycles);
+            this.input = null;
+            this.teleport(room);
+            this.input = function() { return randomInput.nextFrame(); };
+            resets++;
+        }
+    }
+    return summarize(room, samples, nmiSamples, lagFrames, resets);
+};
+
+function summarize(room, samples, nmiSamples, lagFrames, resets) {
+    var sorted = samples.slice().sort(function(a, b) { return a - b; }),
+        total = samples.reduce(function(sum, value) { return sum + value; }, 0);
+    return {
+        room: room,
+        frames: samples.length,
+        max: sorted[sorted.length - 1],
+        p99: sorted[Math.max(0, Math.ceil(sorted.length * 0.99) - 1)],
+        mean: Math.round(total / samples.length),
+        nmiMax: Math.max.apply(Math, nmiSamples),
+        lagFrames: lagFrames,
+        resets: resets
+    };
+}
+
+// Worker processes get the rom once, boot it, then take rooms one at a time until there are none left.
+function runWorker() {
+    var runner = null;
+    process.on('message', function(message) {
+        try {
+            if (message.type === 'start') {
+                runner = new GameRunner(fs.readFileSync(message.romFile), message.symbols);
+                runner.boot();
+                process.send({type: 'ready'});
+            } else if (message.type === 'room') {
+                process.send({type: 'result', result: runner.measureRoom(message.room, message.frames, message.seed)});
+            } else if (message.type === 'done') {
+                process.exit(0);
+            }
+        } catch (e) {
+            process.send({type: 'error', room: message.room, message: e.message});
+        }
+    });
+}
+
+// ===== Splitting up the work, and the report (this part runs in the main process) =====
+
+function printResults(results) {
+    var budget = Math.floor(Nes.CPU_CYCLES_PER_FRAME);
+    results.sort(function(a, b) { return (b.max - a.max) || (b.p99 - a.p99) || (a.room - b.room); });
+
+    out('Frame cost by room, slowest first, in cpu cycles. A frame has ' + budget + '; the nmi handler\'s share is listed on its own.');
+    out(' Room (x,y) |     Max  % frame |     P99 |    Mean | Max nmi |  Lag');
+    out('------------+------------------+---------+---------+---------+------');
+    results.forEach(function(result) {
+        out(padLeft(result.room, 5) + ' (' + (result.room % roomsWide) + ',' + Math.floor(result.room / roomsWide) + ') |' +
+            padLeft(result.max, 8) + padLeft(Math.round(result.max * 100 / budget) + '%', 10) + ' |' +
+            padLeft(result.p99, 8) + ' |' +
+            padLeft(result.mean, 8) + ' |' +
+            padLeft(result.nmiMax, 8) + ' |' +
+            padLeft(result.lagFrames, 5));
+    });
+
+    var lagRooms = results.filter(function(result) { return result.lagFrames > 0; });
+    if (lagRooms.length) {
+        out(lagRooms.length + ' room(s) had lag frames: ' + lagRooms.map(function(result) { return result.room; }).join(', '));
+    } else {
+        out('No lag frames in any room.');
+    }
+}
+
+function runMain() {
+    var args = process.argv.slice(2),
+        files = [],
+        options = {frames: 3000, rooms: null, seed: 1, workers: os.cpus().length, json: null, mapHeader: DEFAULT_MAP_HEADER};
+
+    for (var i = 0; i < args.length; i++) {
+        var arg = args[i];
+        if (arg === '--frames' || arg === '--seed' || arg === '--workers') {
+            options[arg.substr(2)] = parseInt(args[++i], 10);
+        } else if (arg === '--rooms') {
+            // Checked once we know how many rooms there are, below.
+            options.rooms = args[++i] || '';
+        } else if (arg === '--json') {
+            options.json = args[++i];
+        } else if (arg === '--map-header') {
+            options.mapHeader = args[++i];
+        } else if (arg === '--verbose') {
+            logLevel = 'verbose';
+        } else if (arg.indexOf('--') === 0) {
+            out('Unknown option: ' + arg);
+            printUsage();
+            process.exit(1);
+        } else {
+            files.push(arg);
+        }
+    }
+    if (files.length !== 2 || !(options.frames > 0) || isNaN(options.seed) || !(options.workers > 0)) {
+        printUsage();
+        process.exit(1);
+    }
+
+    readWorldSize(options.mapHeader);
+
+    var romFile = files[0],
+        symbols = parseSymbols(fs.readFileSync(files[1], 'utf8')),
+        rooms = parseRooms(options.rooms !== null ? options.rooms : '0-' + (roomCount - 1)),
+        queue = rooms.slice(),
+        results = [],
+        failed = false,
+        workerCount = Math.min(options.workers, rooms.length),
+        finishedWorkers = 0,
+        startTime = Date.now();
+
+    // Pass along only what the workers use.
+    var workerSymbols = {};
+    SYMBOLS.forEach(function(name) { workerSymbols[name] = symbols[name]; });
+
+    out('Timing ' + options.frames + ' frames in each of ' + rooms.length + ' rooms, with ' + workerCount + ' emulator(s)...');
+
+    function giveWork(worker) {
+        if (!queue.length || failed) {
+            worker.send({type: 'done'});
+            return;
+        }
+        var room = queue.shift();
+        verbose('Starting room ' + room);
+        worker.send({type: 'room', room: room, frames: options.frames, seed: options.seed});
+    }
+
+    for (var w = 0; w < workerCount; w++) {
+        var worker = childProcess.fork(path.join(__dirname, 'index.js'), ['--worker']);
+        worker.on('message', function(message) {
+            if (message.type === 'ready') {
+                giveWork(this);
+            } else if (message.type === 'result') {
+                results.push(message.result);
+                verbose('Room ' + message.result.room + ' done: max ' + message.result.max);
+                giveWork(this);
+            } else if (message.type === 'error') {
+                out('Error' + (message.room !== undefined ? ' in room ' + message.room : '') + ': ' + message.message);
+                failed = true;
+                this.send({type: 'done'});
+            }
+        }.bind(worker));
+        worker.on('exit', function() {
+            if (++finishedWorkers < workerCount) {
+                return;
+            }
+            if (failed || results.length !== rooms.length) {
+                out('Stopped early; not every room was timed.');
+                process.exit(1);
+            }
+            printResults(results);
+            out('Done in ' + ((Date.now() - startTime) / 1000).toFixed(1) + ' seconds.');
+            if (options.json) {
+                fs.writeFileSync(options.json, JSON.stringify(results, null, 2));
+                out('Wrote results to ' + options.json);
+            }
+        });
+        worker.send({type: 'start', romFile: romFile, symbols: workerSymbols});
+    }
+}
+
+if (process.argv[2] === '--worker') {
+    runWorker();
+} else {
+    runMain();
+}
@@ -0,0 +1,689 @@
+/**
+ * A small, headless NES emulator, built for one job: running the game's code and counting cpu cycles. It has a
+ * complete (official opcode) 6502 with exact cycle counts, the MMC1 mapper, the first controller, and enough of the
+ * ppu's timing to get vblank, nmi and sprite 0 hits at the right times. It never draws anything.
+ *
+ * What it leaves out:
+ * - The ppu never renders. Writes to vram are kept, so the game can read them back, but that's it.
+ * - Sprite 0 hit happens on the sprite's first line, without checking whether any pixels actually overlap.
+ * - The apu is ignored entirely. (Writes do nothing; reads return 0.)
+ * - Illegal opcodes stop the emulator with an error. cc65 never writes them, so hitting one means something crashed.
+ */
+
+var PPU_DOTS_PER_LINE = 341,
+    PPU_LINES_PER_FRAME = 262,
+    PPU_DOTS_PER_FRAME = PPU_DOTS_PER_LINE * PPU_LINES_PER_FRAME,
+    // The ppu runs 3 dots for every cpu cycle, so a frame is a little under 29781 cpu cycles.
+    CPU_CYCLES_PER_FRAME = PPU_DOTS_PER_FRAME / 3,
+    // Dot 1 of line 241 sets the vblank flag, and dot 1 of the pre-render line (261) clears it again.
+    VBLANK_START_DOT = 241 * PPU_DOTS_PER_LINE + 1,
+    VBLANK_END_DOT = 261 * PPU_DOTS_PER_LINE + 1,
+
+    FLAG_C = 0x01,
+    FLAG_Z = 0x02,
+    FLAG_I = 0x04,
+    FLAG_D = 0x08,
+    FLAG_B = 0x10,
+    FLAG_U = 0x20,
+    FLAG_V = 0x40,
+    FLAG_N = 0x80;
+
+// ===== Opcode table =====
+// Every official opcode, as [name, addressing mode, cycles, +1 cycle when crossing a page]. Branches work out their
+// extra cycles on their own.
+var OPCODES = new Array(256);
+
+function op(code, name, mode, cycles, pageCycle) {
+    OPCODES[code] = {name: name, mode: mode, cycles: cycles, pageCycle: !!pageCycle};
+}
+
+// The "group one" instructions all share the same layout of addressing modes, starting at (zp,x).
+function aluGroup(name, base, isStore) {
+    op(base, name, 'izx', 6);
+    op(base + 0x04, name, 'zp', 3);
+    if (!isStore) {
+        op(base + 0x08, name, 'imm', 2);
+    }
+    op(base + 0x0c, name, 'abs', 4);
+    op(base + 0x10, name, 'izy', isStore ? 6 : 5, !isStore);
+    op(base + 0x14, name, 'zpx', 4);
+    op(base + 0x18, name, 'absy', isStore ? 5 : 4, !isStore);
+    op(base + 0x1c, name, 'absx', isStore ? 5 : 4, !isStore);
+}
+
+// Shifts, rotates, inc and dec read a value, change it, and write it back.
+function rmwGroup(name, base, hasAccumulator) {
+    op(base, name, 'zp', 5);
+    if (hasAccumulator) {
+        op(base + 0x04, name, 'acc', 2);
+    }
+    op(base + 0x08, name, 'abs', 6);
+    op(base + 0x10, name, 'zpx', 6);
+    op(base + 0x18, name, 'absx', 7);
+}
+
+aluGroup('ORA', 0x01);
+aluGroup('AND', 0x21);
+aluGroup('EOR', 0x41);
+aluGroup('ADC', 0x61);
+aluGroup('STA', 0x81, true);
+aluGroup('LDA', 0xa1);
+aluGroup('CMP', 0xc1);
+aluGroup('SBC', 0xe1);
+
+rmwGroup('ASL', 0x06, true);
+rmwGroup('ROL', 0x26, true);
+rmwGroup('LSR', 0x46, true);
+rmwGroup('ROR', 0x66, true);
+rmwGroup('DEC', 0xc6);
+rmwGroup('INC', 0xe6);
+
+op(0xa2, 'LDX', 'imm', 2); op(0xa6, 'LDX', 'zp', 3); op(0xb6, 'LDX', 'zpy', 4); op(0xae, 'LDX', 'abs', 4); op(0xbe, 'LDX', 'absy', 4, true);
+op(0xa0, 'LDY', 'imm', 2); op(0xa4, 'LDY', 'zp', 3); op(0xb4, 'LDY', 'zpx', 4); op(0xac, 'LDY', 'abs', 4); op(0xbc, 'LDY', 'absx', 4, true);
+op(0x86, 'STX', 'zp', 3); op(0x96, 'STX', 'zpy', 4); op(0x8e, 'STX', 'abs', 4);
+op(0x84, 'STY', 'zp', 3); op(0x94, 'STY', 'zpx', 4); op(0x8c, 'STY', 'abs', 4);
+op(0xe0, 'CPX', 'imm', 2); op(0xe4, 'CPX', 'zp', 3); op(0xec, 'CPX', 'abs', 4);
+op(0xc0, 'CPY', 'imm', 2); op(0xc4, 'CPY', 'zp', 3); op(0xcc, 'CPY', 'abs', 4);
+op(0x24, 'BIT', 'zp', 3); op(0x2c, 'BIT', 'abs', 4);
+
+op(0x10, 'BPL', 'rel', 2); op(0x30, 'BMI', 'rel', 2); op(0x50, 'BVC', 'rel', 2); op(0x70, 'BVS', 'rel', 2);
+op(0x90, 'BCC', 'rel', 2); op(0xb0, 'BCS', 'rel', 2); op(0xd0, 'BNE', 'rel', 2); op(0xf0, 'BEQ', 'rel', 2);
+
+op(0x4c, 'JMP', 'abs', 3); op(0x6c, 'JMP', 'ind', 5);
+op(0x20, 'JSR', 'abs', 6); op(0x60, 'RTS', 'imp', 6); op(0x40, 'RTI', 'imp', 6); op(0x00, 'BRK', 'imp', 7);
+op(0x48, 'PHA', 'imp', 3); op(0x08, 'PHP', 'imp', 3); op(0x68, 'PLA', 'imp', 4); op(0x28, 'PLP', 'imp', 4);
+
+op(0x18, 'CLC', 'imp', 2); op(0x38, 'SEC', 'imp', 2); op(0x58, 'CLI', 'imp', 2); op(0x78, 'SEI', 'imp', 2);
+op(0xb8, 'CLV', 'imp', 2); op(0xd8, 'CLD', 'imp', 2); op(0xf8, 'SED', 'imp', 2);
+op(0xaa, 'TAX', 'imp', 2); op(0x8a, 'TXA', 'imp', 2); op(0xa8, 'TAY', 'imp', 2); op(0x98, 'TYA', 'imp', 2);
+op(0xba, 'TSX', 'imp', 2); op(0x9a, 'TXS', 'imp', 2);
+op(0xe8, 'INX', 'imp', 2); op(0xca, 'DEX', 'imp', 2); op(0xc8, 'INY', 'imp', 2); op(0x88, 'DEY', 'imp', 2);
+op(0xea, 'NOP', 'imp', 2);
+
+// ===== The console =====
+
+/**
+ * Creates a console with the given rom (a Buffer with the whole .nes file in it) plugged in. Call reset() before
+ * running anything.
+ */
+function Nes(romData) {
+    if (romData.length < 16 || romData.toString('latin1', 0, 4) !== 'NES\x1a') {
+        throw new Error('This is not an iNES rom file.');
+    }
+    var mapper = (romData[6] >> 4) | (romData[7] & 0xf0),
+        prgStart = 16 + ((romData[6] & 0x04) ? 512 : 0);
+    if (mapper !== 1) {
+        throw new Error('Only MMC1 (mapper 1) roms are supported; this rom uses mapper ' + mapper + '.');
+    }
+    this.prg = new Uint8Array(romData.slice(prgStart, prgStart + romData[4] * 0x4000));
+    this.prgBankCount = romData[4];
+    if (this.prg.length !== this.prgBankCount * 0x4000) {
+        throw new Error('The rom file is cut short.');
+    }
+
+    this.ram = new Uint8Array(0x800);
+    this.wram = new Uint8Array(0x2000);
+    this.vram = new Uint8Array(0x4000);
+    this.oam = new Uint8Array(0x100);
+
+    // Buttons currently held on the first controller. (PAD_ bits, same as neslib uses)
+    this.buttons = 0;
+}
+
+/**
+ * Turns the console on, (or presses reset) the same way the real hardware does.
+ */
+Nes.prototype.reset = function() {
+    this.a = 0;
+    this.x = 0;
+    this.y = 0;
+    this.sp = 0xfd;
+    this.p = FLAG_I | FLAG_U;
+    this.cycles = 0;
+    this.nmiPending = false;
+    // How many times an nmi has happened, and how many cycles have been spent inside of nmi handlers.
+    this.nmiCount = 0;
+    this.nmiCycles = 0;
+    this.nmiDepth = 0;
+
+    this.ppuCtrl = 0;
+    this.ppuMask = 0;
+    this.ppuStatus = 0;
+    this.ppuDot = 0;
+    this.ppuLatch = false;
+    this.ppuAddress = 0;
+    this.ppuReadBuffer = 0;
+    this.oamAddress = 0;
+
+    this.padStrobe = 0;
+    this.padShift = 0;
+
+    // MMC1 starts with the last bank fixed at $c000, which is where the reset vector lives.
+    this.mmc1Shift = 0x10;
+    this.mmc1Control = 0x0c;
+    this.mmc1Prg = 0;
+    this.updatePrgBanks();
+
+    this.pc = this.read16(0xfffc);
+};
+
+// ===== Saving and loading state =====
+
+/**
+ * Returns a copy of everything about the console, which can be handed to restore() to go back to that exact moment.
+ */
+Nes.prototype.snapshot = function() {
+    var state = {};
+    Object.keys(this).forEach(function(key) {
+        var value = this[key];
+        if (key === 'prg') {
+            return;
+        }
+        state[key] = (value instanceof Uint8Array || Array.isArray(value)) ? value.slice() : value;
+    }, this);
+    return state;
+};
+
+Nes.prototype.restore = function(state) {
+    Object.keys(state).forEach(function(key) {
+        var value = state[key];
+        if (value instanceof Uint8Array) {
+            this[key].set(value);
+        } else if (Array.isArray(value)) {
+            this[key] = value.slice();
+        } else {
+            this[key] = value;
+        }
+    }, this);
+};
+
+// ===== Memory map =====
+
+Nes.prototype.read = function(address) {
+    if (address < 0x2000) {
+        return this.ram[address & 0x7ff];
+    } else if (address >= 0x8000) {
+        return this.prg[this.prgOffsets[(address >> 14) & 1] + (address & 0x3fff)];
+    } else if (address >= 0x6000) {
+        return this.wram[address - 0x6000];
+    } else if (address < 0x4000) {
+        return this.readPpu(address & 7);
+    } else if (address === 0x4016) {
+        return this.readPad();
+    } else if (address === 0x4017) {
+        // Nothing plugged into the second port.
+        return 0x40;
+    }
+    return 0;
+};
+
+Nes.prototype.write = function(address, value) {
+    if (address < 0x2000) {
+        this.ram[address & 0x7ff] = value;
+    } else if (address >= 0x8000) {
+        this.writeMmc1(address, value);
+    } else if (address >= 0x6000) {
+        if (!(this.mmc1Prg & 0x10)) {
+            this.wram[address - 0x6000] = value;
+        }
+    } else if (address < 0x4000) {
+        this.writePpu(address & 7, value);
+    } else if (address === 0x4014) {
+        this.oamDma(value);
+    } else if (address === 0x4016) {
+        this.padStrobe = value & 1;
+        if (this.padStrobe) {
+            this.padShift = this.buttons;
+        }
+    }
+};
+
+Nes.prototype.read16 = function(address) {
+    return this.read(address) | (this.read((address + 1) & 0xffff) << 8);
+};
+
+// ===== Mapper (MMC1) =====
+
+Nes.prototype.writeMmc1 = function(address, value) {
+    if (value & 0x80) {
+        this.mmc1Shift = 0x10;
+        this.mmc1Control |= 0x0c;
+        this.updatePrgBanks();
+        return;
+    }
+    // Bits come in one at a time; the 5th write lands the value in the register picked by the address.
+    var done = this.mmc1Shift & 1;
+    this.mmc1Shift = (this.mmc1Shift >> 1) | ((value & 1) << 4);
+    if (!done) {
+        return;
+    }
+    var register = (address >> 13) & 3;
+    if (register === 0) {
+        this.mmc1Control = this.mmc1Shift;
+    } else if (register === 3) {
+        this.mmc1Prg = this.mmc1Shift;
+    }
+    // (Registers 1 and 2 pick chr banks, which we don't draw.)
+    this.mmc1Shift = 0x10;
+    this.updatePrgBanks();
+};
+
+Nes.prototype.updatePrgBanks = function() {
+    var bank = this.mmc1Prg & 0x0f,
+        last = this.prgBankCount - 1;
+    switch ((this.mmc1Control >> 2) & 3) {
+        case 0:
+        case 1:
+            // 32k at a time
+            this.prgOffsets = [(bank & 0x0e) % this.prgBankCount, ((bank & 0x0e) + 1) % this.prgBankCount];
+            break;
+        case 2:
+            this.prgOffsets = [0, bank % this.prgBankCount];
+            break;
+        case 3:
+            this.prgOffsets = [bank % this.prgBankCount, last];
+            break;
+    }
+    this.prgOffsets[0] *= 0x4000;
+    this.prgOffsets[1] *= 0x4000;
+};
+
+// ===== Controller =====
+
+Nes.prototype.readPad = function() {
+    if (this.padStrobe) {
+        return 0x40 | (this.buttons & 1);
+    }
+    var bit = this.padShift & 1;
+    // Once all 8 buttons are read out, a real controller returns 1s from then on.
+    this.padShift = (this.padShift >> 1) | 0x80;
+    return 0x40 | bit;
+};
+
+// ===== PPU (timing only) =====
+
+Nes.prototype.readPpu = function(register) {
+    var value;
+    switch (register) {
+        case 2:
+            value = this.ppuStatus;
+            this.ppuStatus &= 0x7f;
+            this.ppuLatch = false;
+            return value;
+        case 4:
+            return this.oam[this.oamAddress];
+        case 7:
+            value = this.ppuReadBuffer;
+            this.ppuReadBuffer = this.vram[this.ppuAddress & 0x3fff];
+            if ((this.ppuAddress & 0x3fff) >= 0x3f00) {
+                // Palette reads skip the buffer.
+                value = this.ppuReadBuffer;
+            }
+            this.ppuAddress = (this.ppuAddress + ((this.ppuCtrl & 0x04) ? 32 : 1)) & 0x7fff;
+            return value;
+    }
+    return 0;
+};
+
+Nes.prototype.writePpu = function(register, value) {
+    switch (register) {
+        case 0:
+            // Turning on nmi in the middle of vblank fires one right away.
+            if ((value & 0x80) && !(this.ppuCtrl & 0x80) && (this.ppuStatus & 0x80)) {
+                this.nmiPending = true;
+            }
+            this.ppuCtrl = value;
+            break;
+        case 1:
+            this.ppuMask = value;
+            break;
+        case 3:
+            this.oamAddress = value;
+            break;
+        case 4:
+            this.oam[this.oamAddress] = value;
+            this.oamAddress = (this.oamAddress + 1) & 0xff;
+            break;
+        case 5:
+            this.ppuLatch = !this.ppuLatch;
+            break;
+        case 6:
+            if (!this.ppuLatch) {
+                this.ppuAddress = (this.ppuAddress & 0xff) | ((value & 0x3f) << 8);
+            } else {
+                this.ppuAddress = (this.ppuAddress & 0xff00) | value;
+            }
+            this.ppuLatch = !this.ppuLatch;
+            break;
+        case 7:
+            this.vram[this.ppuAddress & 0x3fff] = value;
+            this.ppuAddress = (this.ppuAddress + ((this.ppuCtrl & 0x04) ? 32 : 1)) & 0x7fff;
+            break;
+    }
+};
+
+Nes.prototype.oamDma = function(page) {
+    var base = page << 8;
+    for (var i = 0; i < 256; i++) {
+        this.oam[(this.oamAddress + i) & 0xff] = this.read(base + i);
+    }
+    // The cpu is stalled while the copy happens; one more cycle if it starts on an odd one.
+    this.addCycles(513 + (this.cycles & 1));
+};
+
+// Moves the ppu forward by the given number of cpu cycles (3 dots each) and sets its flags as it goes.
+Nes.prototype.addCycles = function(cycles) {
+    var before = this.ppuDot,
+        after = before + cycles * 3;
+    this.cycles += cycles;
+    if (this.nmiDepth) {
+        this.nmiCycles += cycles;
+    }
+
+    if (before < VBLANK_START_DOT && after >= VBLANK_START_DOT) {
+        this.ppuStatus |= 0x80;
+        this.nmiCount++;
+        if (this.ppuCtrl & 0x80) {
+            this.nmiPending = true;
+        }
+    }
+    // Sprite 0 hit: set on sprite 0's first line, as long as both backgrounds and sprites are on.
+    if ((this.ppuMask & 0x18) === 0x18 && this.oam[0] < 239 && !(this.ppuStatus & 0x40)) {
+        var hitDot = (this.oam[0] + 1) * PPU_DOTS_PER_LINE + this.oam[3] + 1;
+        if (before < hitDot && after >= hitDot) {
+            this.ppuStatus |= 0x40;
+        }
+    }
+    if (before < VBLANK_END_DOT && after >= VBLANK_END_DOT) {
+        this.ppuStatus &= 0x1f;
+    }
+    // Even oam dma is far shorter than the time between the end of one frame and vblank in the next, so there's
+    // never more than one frame boundary to deal with here.
+    if (after >= PPU_DOTS_PER_FRAME) {
+        after -= PPU_DOTS_PER_FRAME;
+    }
+    this.ppuDot = after;
+};
+
+// ===== CPU =====
+
+Nes.prototype.push = function(value) {
+    this.ram[0x100 | this.sp] = value;
+    this.sp = (this.sp - 1) & 0xff;
+};
+
+Nes.prototype.pull = function() {
+    this.sp = (this.sp + 1) & 0xff;
+    return this.ram[0x100 | this.sp];
+};
+
+Nes.prototype.setZN = function(value) {
+    this.p = (this.p & ~(FLAG_Z | FLAG_N)) | (value ? 0 : FLAG_Z) | (value & FLAG_N);
+    return value;
+};
+
+Nes.prototype.setFlag = function(flag, on) {
+    if (on) {
+        this.p |= flag;
+    } else {
+        this.p &= ~flag;
+    }
+};
+
+Nes.prototype.interrupt = function(vector, isBreak) {
+    this.push(this.pc >> 8);
+    this.push(this.pc & 0xff);
+    this.push((this.p | FLAG_U | (isBreak ? FLAG_B : 0)) & (isBreak ? 0xff : ~FLAG_B));
+    this.p |= FLAG_I;
+    this.pc = this.read16(vector);
+};
+
+/**
+ * Runs a single instruction (or starts an nmi) and returns how many cpu cycles it took.
+ */
+Nes.prototype.step = function() {
+    if (this.nmiPending) {
+        this.nmiPending = false;
+        this.interrupt(0xfffa, false);
+        this.nmiDepth++;
+        this.addCycles(7);
+        return 7;
+    }
+
+    var opcode = this.read(this.pc),
+        info = OPCODES[opcode];
+    if (!info) {
+        throw new Error('Illegal opcode $' + hex(opcode, 2) + ' at $' + hex(this.pc, 4) + '. The game probably crashed.');
+    }
+    this.pc = (this.pc + 1) & 0xffff;
+
+    var address = 0,
+        cycles = info.cycles,
+        pageCrossed = false,
+        base, pointer;
+
+    switch (info.mode) {
+        case 'imm':
+            address = this.pc;
+            this.pc = (this.pc + 1) & 0xffff;
+            break;
+        case 'zp':
+            address = this.read(this.pc);
+            this.pc = (this.pc + 1) & 0xffff;
+            break;
+        case 'zpx':
+            address = (this.read(this.pc) + this.x) & 0xff;
+            this.pc = (this.pc + 1) & 0xffff;
+            break;
+        case 'zpy':
+            address = (this.read(this.pc) + this.y) & 0xff;
+            this.pc = (this.pc + 1) & 0xffff;
+            break;
+        case 'abs':
+            address = this.read16(this.pc);
+            this.pc = (this.pc + 2) & 0xffff;
+            break;
+        case 'absx':
+            base = this.read16(this.pc);
+            address = (base + this.x) & 0xffff;
+            pageCrossed = (base & 0xff00) !== (address & 0xff00);
+            this.pc = (this.pc + 2) & 0xffff;
+            break;
+        case 'absy':
+            base = this.read16(this.pc);
+            address = (base + this.y) & 0xffff;
+            pageCrossed = (base & 0xff00) !== (address & 0xff00);
+            this.pc = (this.pc + 2) & 0xffff;
+            break;
+        case 'ind':
+            // The famous 6502 bug: the pointer's high byte never crosses into the next page.
+            pointer = this.read16(this.pc);
+            address = this.read(pointer) | (this.read((pointer & 0xff00) | ((pointer + 1) & 0xff)) << 8);
+            this.pc = (this.pc + 2) & 0xffff;
+            break;
+        case 'izx':
+            pointer = (this.read(this.pc) + this.x) & 0xff;
+            address = this.ram[pointer] | (this.ram[(pointer + 1) & 0xff] << 8);
+            this.pc = (this.pc + 1) & 0xffff;
+            break;
+        case 'izy':
+            pointer = this.read(this.pc);
+            base = this.ram[pointer] | (this.ram[(pointer + 1) & 0xff] << 8);
+            address = (base + this.y) & 0xffff;
+            pageCrossed = (base & 0xff00) !== (address & 0xff00);
+            this.pc = (this.pc + 1) & 0xffff;
+            break;
+        case 'rel':
+            base = this.read(this.pc);
+            this.pc = (this.pc + 1) & 0xffff;
+            address = (this.pc + (base < 0x80 ? base : base - 0x100)) & 0xffff;
+            break;
+    }
+    if (pageCrossed && info.pageCycle) {
+        cycles++;
+    }
+
+    var value, result;
+    switch (info.name) {
+        // Loads, stores and transfers
+        case 'LDA': this.a = this.setZN(this.read(address)); break;
+        case 'LDX': this.x = this.setZN(this.read(address)); break;
+        case 'LDY': this.y = this.setZN(this.read(address)); break;
+        case 'STA': this.write(address, this.a); break;
+        case 'STX': this.write(address, this.x); break;
+        case 'STY': this.write(address, this.y); break;
+        case 'TAX': this.x = this.setZN(this.a); break;
+        case 'TXA': this.a = this.setZN(this.x); break;
+        case 'TAY': this.y = this.setZN(this.a); break;
+        case 'TYA': this.a = this.setZN(this.y); break;
+        case 'TSX': this.x = this.setZN(this.sp); break;
+        case 'TXS': this.sp = this.x; break;
+
+        // Math and logic. (The NES's cpu has no decimal mode, so ADC and SBC ignore the D flag.)
+        case 'ORA': this.a = this.setZN(this.a | this.read(address)); break;
+        case 'AND': this.a = this.setZN(this.a & this.read(address)); break;
+        case 'EOR': this.a = this.setZN(this.a ^ this.read(address)); break;
+        case 'ADC':
+        case 'SBC':
+            value = this.read(address);
+            if (info.name === 'SBC') {
+                value ^= 0xff;
+            }
+            result = this.a + value + (this.p & FLAG_C);
+            this.setFlag(FLAG_C, result > 0xff);
+            this.setFlag(FLAG_V, (~(this.a ^ value) & (this.a ^ result) & 0x80) !== 0);
+            this.a = this.setZN(result & 0xff);
+            break;
+        case 'CMP': this.compare(this.a, this.read(address)); break;
+        case 'CPX': this.compare(this.x, this.read(address)); break;
+        case 'CPY': this.compare(this.y, this.read(address)); break;
+        case 'BIT':
+            value = this.read(address);
+            this.p = (this.p & ~(FLAG_Z | FLAG_V | FLAG_N)) | ((this.a & value) ? 0 : FLAG_Z) | (value & (FLAG_V | FLAG_N));
+            break;
+
+        // Read-modify-write
+        case 'ASL':
+        case 'LSR':
+        case 'ROL':
+        case 'ROR':
+        case 'INC':
+        case 'DEC':
+            value = info.mode === 'acc' ? this.a : this.read(address);
+            switch (info.name) {
+                case 'ASL':
+                    this.setFlag(FLAG_C, value & 0x80);
+                    value = (value << 1) & 0xff;
+                    break;
+                case 'LSR':
+                    this.setFlag(FLAG_C, value & 0x01);
+                    value >>= 1;
+                    break;
+                case 'ROL':
+                    result = ((value << 1) | (this.p & FLAG_C)) & 0xff;
+                    this.setFlag(FLAG_C, value & 0x80);
+                    value = result;
+                    break;
+                case 'ROR':
+                    result = (value >> 1) | ((this.p & FLAG_C) << 7);
+                    this.setFlag(FLAG_C, value & 0x01);
+                    value = result;
+                    break;
+                case 'INC':
+                    value = (value + 1) & 0xff;
+                    break;
+                case 'DEC':
+                    value = (value - 1) & 0xff;
+                    break;
+            }
+            this.setZN(value);
+            if (info.mode === 'acc') {
+                this.a = value;
+            } else {
+                this.write(address, value);
+            }
+            break;
+        case 'INX': this.x = this.setZN((this.x + 1) & 0xff); break;
+        case 'DEX': this.x = this.setZN((this.x - 1) & 0xff); break;
+        case 'INY': this.y = this.setZN((this.y + 1) & 0xff); break;
+        case 'DEY': this.y = this.setZN((this.y - 1) & 0xff); break;
+
+        // Branches: one extra cycle if taken, and another if that lands on a different page.
+        case 'BPL': cycles += this.branch(!(this.p & FLAG_N), address); break;
+        case 'BMI': cycles += this.branch(this.p & FLAG_N, address); break;
+        case 'BVC': cycles += this.branch(!(this.p & FLAG_V), address); break;
+        case 'BVS': cycles += this.branch(this.p & FLAG_V, address); break;
+        case 'BCC': cycles += this.branch(!(this.p & FLAG_C), address); break;
+        case 'BCS': cycles += this.branch(this.p & FLAG_C, address); break;
+        case 'BNE': cycles += this.branch(!(this.p & FLAG_Z), address); break;
+        case 'BEQ': cycles += this.branch(this.p & FLAG_Z, address); break;
+
+        // Jumps, calls and the stack
+        case 'JMP': this.pc = address; break;
+        case 'JSR':
+            this.pc = (this.pc - 1) & 0xffff;
+            this.push(this.pc >> 8);
+            this.push(this.pc & 0xff);
+            this.pc = address;
+            break;
+        case 'RTS':
+            this.pc = ((this.pull() | (this.pull() << 8)) + 1) & 0xffff;
+            break;
+        case 'RTI':
+            this.p = (this.pull() & ~FLAG_B) | FLAG_U;
+            this.pc = this.pull() | (this.pull() << 8);
+            break;
+        case 'BRK':
+            this.pc = (this.pc + 1) & 0xffff;
+            this.interrupt(0xfffe, true);
+            break;
+        case 'PHA': this.push(this.a); break;
+        case 'PHP': this.push(this.p | FLAG_B | FLAG_U); break;
+        case 'PLA': this.a = this.setZN(this.pull()); break;
+        case 'PLP': this.p = (this.pull() & ~FLAG_B) | FLAG_U; break;
+
+        // Flags
+        case 'CLC': this.p &= ~FLAG_C; break;
+        case 'SEC': this.p |= FLAG_C; break;
+        case 'CLI': this.p &= ~FLAG_I; break;
+        case 'SEI': this.p |= FLAG_I; break;
+        case 'CLV': this.p &= ~FLAG_V; break;
+        case 'CLD': this.p &= ~FLAG_D; break;
+        case 'SED': this.p |= FLAG_D; break;
+        case 'NOP': break;
+    }
+
+    this.addCycles(cycles);
+    // The rti's own cycles still count as part of the nmi.
+    if (opcode === 0x40 && this.nmiDepth) {
+        this.nmiDepth--;
+    }
+    return cycles;
+};
+
+Nes.prototype.compare = function(register, value) {
+    var result = register - value;
+    this.setFlag(FLAG_C, result >= 0);
+    this.setZN(result & 0xff);
+};
+
+Nes.prototype.branch = function(taken, target) {
+    if (!taken) {
+        return 0;
+    }
+    var extra = ((this.pc & 0xff00) !== (target & 0xff00)) ? 2 : 1;
+    this.pc = target;
+    return extra;
+};
+
+function hex(value, digits) {
+    var str = value.toString(16);
+    while (str.length < digits) {
+        str = '0' + str;
+    }
+    return str;
+}
+
+Nes.CPU_CYCLES_PER_FRAME = CPU_CYCLES_PER_FRAME;
+Nes.hex = hex;
+module.exports = Nes;
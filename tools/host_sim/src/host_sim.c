@@ -0,0 +1,369 @@
+/**
+ * Runs the game's logic on your computer instead of on a NES, as fast as it can go. The game code is compiled
+ * unchanged with a regular C compiler, against stand-ins for neslib (neslib_stub.c) that keep the screen, sprites
+ * and palette in plain arrays.
+ *
+ * This is handy for things that need a lot of play time: leaving the game running for hours of game time with random
+ * input to look for crashes (a "soak test"), checking things that should never happen after every frame (see
+ * invariants.c), or trying out changes to enemy behavior without playing through by hand.
+ *
+ * Each time the game resets (game over, or the credits end) that's the end of an "episode". The next episode starts
+ * from a fresh copy of the game, by forking this process before starting the game.
+ *
+ * Build and run it with `make host_sim`. See the README next to this file for all of the options.
+ *
+ * NOTE: This file is built without host_sim.h, so it is regular C; it only talks to the game through host_sim_api.h.
+ */
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "tools/host_sim/src/host_sim_api.h"
+
+#define VERSION "1.0.0"
+
+// The NES runs at just about 60 frames per second. (NTSC)
+#define NES_FRAMES_PER_SECOND 60
+
+// Same order as the PAD_ constants in neslib.h - bit 0 is A.
+static const char *BUTTON_NAMES[8] = {"A", "B", "SELECT", "START", "UP", "DOWN", "LEFT", "RIGHT"};
+#define BUTTON_START 0x08
+#define BUTTON_UP 0x10
+#define BUTTON_DOWN 0x20
+#define BUTTON_LEFT 0x40
+#define BUTTON_RIGHT 0x80
+
+// The longest input script we'll read, in runs of buttons.
+#define MAX_INPUT_RUNS 65536
+
+// ===== Options =====
+
+static uint32_t optionFrames = 36000;
+static uint32_t optionEpisodes = 0;
+static uint32_t optionSeed = 1;
+static const char *optionInputFile = NULL;
+static const char *optionPaletteFolder = "graphics/palettes";
+static const char *optionDumpPrefix = NULL;
+static uint32_t optionTraceInterval = 0;
+static int optionQuiet = 0;
+
+// ===== Input scripts =====
+
+static uint8_t inputRunButtons[MAX_INPUT_RUNS];
+static uint32_t inputRunLengths[MAX_INPUT_RUNS];
+static uint32_t inputRunCount;
+static int inputHasSeed;
+static uint16_t inputSeed;
+
+static uint32_t currentRun, readsLeftInRun;
+static uint8_t currentButtons;
+static uint32_t randomState;
+
+// ===== Episode state =====
+
+typedef struct {
+    uint32_t frames;
+    uint32_t problems;
+    char endReason[200];
+} EpisodeResult;
+
+static jmp_buf episodeEnd;
+static EpisodeResult result;
+static uint32_t frameLimit;
+
+static void print_usage(void) {
+    printf("[host_sim] host_sim version " VERSION "\n");
+    printf("Usage: host_sim [options]\n");
+    printf("  --frames N         Total number of frames to simulate, across all episodes. (Default: 36000; 10 minutes)\n");
+    printf("  --episodes N       Stop after this many episodes, even if there are frames left.\n");
+    printf("  --seed N           Seed for the random button presses. Each episode uses the next seed. (Default: 1)\n");
+    printf("  --input FILE       Play back an input recording (text format from tools/input_recording) instead of\n");
+    printf("                     pressing random buttons. Runs a single episode.\n");
+    printf("  --palettes FOLDER  Where to find the .pal files. (Default: graphics/palettes)\n");
+    printf("  --trace N          Print out where the player is every N frames.\n");
+    printf("  --dump PREFIX      At the end of each episode, write sprites, palette and vram to PREFIX.oam,\n");
+    printf("                     PREFIX.pal and PREFIX.vram.\n");
+    printf("  --quiet            Only print the summary at the end.\n");
+}
+
+static uint32_t parse_number(const char *option, const char *value) {
+    char *end;
+    unsigned long number;
+    if (value == NULL) {
+        fprintf(stderr, "[host_sim] %s needs a value.\n", option);
+        exit(2);
+    }
+    number = strtoul(value, &end, 0);
+    if (*end != '\0') {
+        fprintf(stderr, "[host_sim] %s expects a number, got \"%s\"\n", option, value);
+        exit(2);
+    }
+    return (uint32_t)number;
+}
+
+static uint8_t parse_buttons(char *text, uint32_t lineNumber) {
+    uint8_t buttons = 0;
+    char *name;
+    int bit;
+    if (strcmp(text, "-") == 0) {
+        return 0;
+    }
+    for (name = strtok(text, "+"); name != NULL; name = strtok(NULL, "+")) {
+        for (bit = 0; bit != 8; ++bit) {
+            if (strcasecmp(name, BUTTON_NAMES[bit]) == 0) {
+                buttons |= (1 << bit);
+                break;
+            }
+        }
+        if (bit == 8) {
+            fprintf(stderr, "[host_sim] Unknown button \"%s\" on line %u of the input file.\n", name, lineNumber);
+            exit(2);
+        }
+    }
+    return buttons;
+}
+
+// Reads the same text format tools/input_recording writes: "seed N", then lines of "count buttons".
+static void load_input_file(const char *fileName) {
+    char line[256], buttons[128];
+    unsigned long count, seed;
+    uint32_t lineNumber = 0;
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) {
+        fprintf(stderr, "[host_sim] Could not open input file %s\n", fileName);
+        exit(2);
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {
+        ++lineNumber;
+        if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0') {
+            continue;
+        }
+        if (sscanf(line, " seed %lu", &seed) == 1) {
+            inputHasSeed = 1;
+            inputSeed = (uint16_t)seed;
+            continue;
+        }
+        strcpy(buttons, "-");
+        if (sscanf(line, " %lu %127s", &count, buttons) < 1 || count == 0) {
+            fprintf(stderr, "[host_sim] Expected a number of reads at the start of line %u of the input file.\n", lineNumber);
+            exit(2);
+        }
+        if (inputRunCount == MAX_INPUT_RUNS) {
+            fprintf(stderr, "[host_sim] Input file is too long; only the first %u runs will be used.\n", MAX_INPUT_RUNS);
+            break;
+        }
+        inputRunLengths[inputRunCount] = (uint32_t)count;
+        inputRunButtons[inputRunCount] = parse_buttons(buttons, lineNumber);
+        ++inputRunCount;
+    }
+    fclose(file);
+}
+
+// xorshift32; plenty random enough for mashing buttons.
+static uint32_t next_random(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// Picks what a player mashing on the controller might do next: mostly walking around in one or two directions for a
+// while, sometimes standing still, and every so often tapping start.
+static void next_random_run(void) {
+    static const uint8_t directions[9] = {
+        0, BUTTON_UP, BUTTON_DOWN, BUTTON_LEFT, BUTTON_RIGHT,
+        BUTTON_UP | BUTTON_LEFT, BUTTON_UP | BUTTON_RIGHT, BUTTON_DOWN | BUTTON_LEFT, BUTTON_DOWN | BUTTON_RIGHT
+    };
+    if (next_random() % 40 == 0) {
+        currentButtons = BUTTON_START;
+        readsLeftInRun = 1;
+        return;
+    }
+    currentButtons = directions[next_random() % 9];
+    readsLeftInRun = 1 + (next_random() % 45);
+}
+
+uint8_t host_sim_next_input(void) {
+    while (readsLeftInRun == 0) {
+        if (optionInputFile == NULL) {
+            next_random_run();
+        } else if (currentRun == inputRunCount) {
+            host_sim_end_episode("input file finished");
+        } else {
+            currentButtons = inputRunButtons[currentRun];
+            readsLeftInRun = inputRunLengths[currentRun];
+            ++currentRun;
+        }
+    }
+    --readsLeftInRun;
+    return currentButtons;
+}
+
+uint16_t host_sim_random_seed(uint16_t seed) {
+    return inputHasSeed ? inputSeed : seed;
+}
+
+void host_sim_end_frame(uint8_t mainLoopFrame) {
+    char state[128];
+    ++result.frames;
+    if (mainLoopFrame) {
+        result.problems += host_sim_check_invariants(result.frames);
+    }
+    if (optionTraceInterval && result.frames % optionTraceInterval == 0) {
+        host_sim_describe_state(state, sizeof(state));
+        printf("[host_sim] Frame %u: %s\n", result.frames, state);
+    }
+    if (result.frames >= frameLimit) {
+        host_sim_end_episode("frame limit reached");
+    }
+}
+
+void host_sim_end_episode(const char *reason) {
+    snprintf(result.endReason, sizeof(result.endReason), "%s", reason);
+    longjmp(episodeEnd, 1);
+}
+
+static void write_dump(const char *extension, const uint8_t *data, size_t size) {
+    char fileName[512];
+    FILE *file;
+    snprintf(fileName, sizeof(fileName), "%s.%s", optionDumpPrefix, extension);
+    file = fopen(fileName, "wb");
+    if (file == NULL || fwrite(data, 1, size, file) != size) {
+        fprintf(stderr, "[host_sim] Could not write %s\n", fileName);
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+}
+
+// Runs in the forked child: plays the game from power on until the episode ends, then reports back to the parent.
+static void run_episode(uint32_t episode, uint32_t framesAllowed, int resultPipe) {
+    randomState = optionSeed + episode;
+    // xorshift gets stuck on 0.
+    if (randomState == 0) {
+        randomState = 1;
+    }
+    frameLimit = framesAllowed;
+
+    if (setjmp(episodeEnd) == 0) {
+        host_sim_power_on();
+        game_main();
+        snprintf(result.endReason, sizeof(result.endReason), "main() returned");
+    }
+
+    if (optionDumpPrefix != NULL) {
+        write_dump("oam", hostOam, sizeof(hostOam));
+        write_dump("pal", hostPalette, sizeof(hostPalette));
+        write_dump("vram", hostVram, sizeof(hostVram));
+    }
+    fflush(stdout);
+    if (write(resultPipe, &result, sizeof(result)) != sizeof(result)) {
+        _exit(1);
+    }
+    _exit(0);
+}
+
+int main(int argc, char **argv) {
+    uint32_t episode = 0, totalFrames = 0, totalProblems = 0;
+    EpisodeResult episodeResult;
+    struct timespec startTime, endTime;
+    double seconds;
+    int i, pipeEnds[2], status;
+    pid_t child;
+
+    for (i = 1; i < argc; ++i) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--frames") == 0) {
+            optionFrames = parse_number(argv[i], value); ++i;
+        } else if (strcmp(argv[i], "--episodes") == 0) {
+            optionEpisodes = parse_number(argv[i], value); ++i;
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            optionSeed = parse_number(argv[i], value); ++i;
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            optionTraceInterval = parse_number(argv[i], value); ++i;
+        } else if (strcmp(argv[i], "--input") == 0 && value != NULL) {
+            optionInputFile = value; ++i;
+        } else if (strcmp(argv[i], "--palettes") == 0 && value != NULL) {
+            optionPaletteFolder = value; ++i;
+        } else if (strcmp(argv[i], "--dump") == 0 && value != NULL) {
+            optionDumpPrefix = value; ++i;
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            optionQuiet = 1;
+        } else {
+            print_usage();
+            return 2;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    if (host_sim_load_palettes(optionPaletteFolder)) {
+        return 2;
+    }
+    if (optionInputFile != NULL) {
+        load_input_file(optionInputFile);
+        optionEpisodes = 1;
+    }
+
+    while (totalFrames < optionFrames && (optionEpisodes == 0 || episode < optionEpisodes)) {
+        fflush(stdout);
+        if (pipe(pipeEnds) != 0) {
+            perror("[host_sim] pipe");
+            return 2;
+        }
+        child = fork();
+        if (child < 0) {
+            perror("[host_sim] fork");
+            return 2;
+        }
+        if (child == 0) {
+            close(pipeEnds[0]);
+            run_episode(episode, optionFrames - totalFrames, pipeEnds[1]);
+        }
+        close(pipeEnds[1]);
+        if (read(pipeEnds[0], &episodeResult, sizeof(episodeResult)) != sizeof(episodeResult)) {
+            // The game crashed hard enough to take the process down with it. (A segfault, for example)
+            waitpid(child, &status, 0);
+            printf("[host_sim] Episode %u: the simulation crashed! (Exit status %d) Try again with --trace 1 to see how far it got.\n", episode + 1, status);
+            return 1;
+        }
+        close(pipeEnds[0]);
+        waitpid(child, &status, 0);
+
+        if (!optionQuiet) {
+            printf("[host_sim] Episode %u: %u frames, ended by: %s. %u problems found.\n",
+                episode + 1, episodeResult.frames, episodeResult.endReason, episodeResult.problems);
+        }
+        totalFrames += episodeResult.frames;
+        totalProblems += episodeResult.problems;
+        // Any crash_error is a problem, too.
+        if (strncmp(episodeResult.endReason, "crash_error", 11) == 0) {
+            ++totalProblems;
+        }
+        ++episode;
+        // An episode that ends without running any frames would loop forever.
+        if (episodeResult.frames == 0) {
+            break;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+    seconds = (endTime.tv_sec - startTime.tv_sec) + (endTime.tv_nsec - startTime.tv_nsec) / 1e9;
+    printf("[host_sim] Simulated %u frames (%.1f minutes of game time) in %u episodes, in %.2f seconds", totalFrames,
+        (double)totalFrames / NES_FRAMES_PER_SECOND / 60, episode, seconds);
+    if (seconds > 0) {
+        printf(" - %.0fx faster than a real NES", ((double)totalFrames / NES_FRAMES_PER_SECOND) / seconds);
+    }
+    printf(".\n");
+
+    if (totalProblems) {
+        printf("[host_sim] ERROR: Found %u problems.\n", totalProblems);
+        return 1;
+    }
+    printf("[host_sim] No problems found.\n");
+    return 0;
+}
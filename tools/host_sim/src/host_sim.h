@@ -0,0 +1,53 @@
+// This header is force-included (gcc -include) into every game file when building the host simulation, so the game
+// code can compile with a regular C compiler without changing a single line of it. It smooths over the few places
+// where cc65 and gcc/clang disagree.
+//
+// NOTE: This is only for the host simulation build (`make host_sim`). The real game never sees this file.
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+// Pull in the system headers first, before we start redefining things below.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// neslib.h defines NULL as a plain 0; match it so the two don't argue about it.
+#undef NULL
+#define NULL 0
+
+// cc65's calling convention keyword. Meaningless on the host.
+#define __fastcall__
+
+// neslib has its own memcpy and memfill, with a slightly different signature from the C library. Rename them, so
+// they don't clash with string.h. (The stubs in neslib_stub.c implement them.)
+#define memcpy nes_memcpy
+#define memfill nes_memfill
+
+// crt0.asm points oamBuffer at neslib's OAM buffer; here, that's the array the oam_ stubs write to.
+#define oamBuffer hostOam
+
+// The harness has its own main(); the game's main loop is started from there.
+#define main game_main
+
+// cc65 uses 16 bit ints, and a lot of the game relies on that. (Positions wrap around, values get stored into
+// 2 bytes, etc) So, make every int in the game a 16 bit one too.
+// NOTE: The math in the middle of an expression still happens at the host's int size, but everything is stored
+// back as 16 bits, which is what matters for the game's logic.
+#define int short
+
+// Lets the game's headers know they're being built for the host simulation.
+#define HOST_SIM
+
+// There are no segments or zeropage on the host, so these helpers from bank_helpers.h just make regular variables.
+// (cc65 uses _Pragma to pick the segment, and gcc/clang can't read the way those are written.)
+#define ZEROPAGE_DEF(defa, defb) defa defb
+#define ZEROPAGE_ARRAY_DEF(defa, defb, defArr) defa defb[defArr]
+#define WRAM_ARRAY_DEF(defa, defb, defArr) defa defb[defArr]
+#define ZEROPAGE_EXTERN(defa, defb) extern defa defb
+#define ZEROPAGE_ARRAY_EXTERN(defa, defb, defArr) extern defa defb[defArr]
+#define CODE_BANK(id)
+#define CODE_BANK_POP()
+
+#endif
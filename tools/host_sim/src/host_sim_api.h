@@ -0,0 +1,54 @@
+// The functions the harness (host_sim.c) and the hardware stubs (neslib_stub.c, invariants.c) use to talk to each
+// other. The harness is built without host_sim.h, (so its ints are still regular ints) so everything here sticks to
+// fixed-size types.
+
+#ifndef HOST_SIM_API_H
+#define HOST_SIM_API_H
+
+#include <stdint.h>
+
+// ===== Implemented by the harness (host_sim.c) =====
+
+// Called by pad_poll to get the buttons held for the next controller read. (PAD_ bits, just like on the NES)
+uint8_t host_sim_next_input(void);
+
+// Called every time the simulated NES finishes a frame. (At the end of the NMI) mainLoopFrame is set when the game
+// called ppu_wait_frame, which it only does at the end of its main loop; that's the only time the invariant
+// checks are run.
+void host_sim_end_frame(uint8_t mainLoopFrame);
+
+// Called with the random seed the game is about to use. (See input_random_seed in input_recorder.h) Returns the
+// seed to use instead, if the input script has one.
+uint16_t host_sim_random_seed(uint16_t seed);
+
+// Ends the current episode; the game reset the console or crashed. This never returns.
+void host_sim_end_episode(const char *reason);
+
+// ===== Implemented by the hardware stubs (neslib_stub.c) =====
+
+// Everything the simulated PPU would show, kept in plain arrays so the harness can look at or dump them.
+extern uint8_t hostOam[256];
+extern uint8_t hostPalette[32];
+extern uint8_t hostVram[0x4000];
+extern uint8_t hostPaletteBrightness;
+extern uint8_t hostPpuMask;
+
+// Get the simulated console to the state crt0 leaves it in right before it calls the game's main().
+void host_sim_power_on(void);
+
+// Load the palettes the game uses (normally built into the rom by palettes.asm) from the given folder.
+// Returns 0 on success.
+int host_sim_load_palettes(const char *paletteFolder);
+
+// The game's main(), renamed by host_sim.h.
+void game_main(void);
+
+// ===== Implemented by invariants.c =====
+
+// Look at the game's state and print out anything that should never happen. Returns the number of problems found.
+uint32_t host_sim_check_invariants(uint32_t frame);
+
+// Write a one-line summary of where the player is, for the harness's trace output.
+void host_sim_describe_state(char *buffer, uint32_t bufferSize);
+
+#endif
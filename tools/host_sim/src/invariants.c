@@ -0,0 +1,134 @@
+// Checks for things that should never happen in the game, no matter what buttons you press. The harness runs these at
+// the end of every main loop frame while the game is running (not paused, scrolling, etc) and reports anything it
+// finds.
+//
+// Add your own checks at the bottom of host_sim_check_invariants! This file is built just like the game code, so you
+// can use any of the game's variables and headers.
+
+#include "source/neslib_asm/neslib.h"
+#include "source/library/bank_helpers.h"
+#include "source/globals.h"
+#include "source/configuration/game_states.h"
+#include "source/configuration/system_constants.h"
+#include "source/map/map.h"
+#include "source/sprites/player.h"
+#include "source/sprites/map_sprites.h"
+#include "source/sprites/sprite_definitions.h"
+#include "source/sprites/collision.h"
+#include "tools/host_sim/src/host_sim_api.h"
+
+// Defined in bank_helpers.c
+extern char bankLevel;
+
+static uint32_t currentFrame;
+static uint32_t problemCount;
+
+static void report(const char *message) {
+    char state[128];
+    host_sim_describe_state(state, sizeof(state));
+    printf("[host_sim] Frame %u: %s (%s)\n", currentFrame, message, state);
+    ++problemCount;
+}
+
+// Is the given pixel on the screen inside of a solid tile on the current map? Pixels outside the room never are.
+static unsigned char is_solid_pixel(long xPixel, long yPixel) {
+    if (xPixel < 0 || xPixel > 255 || yPixel < HUD_PIXEL_HEIGHT || yPixel >= HUD_PIXEL_HEIGHT + (ROOM_HEIGHT_MAP_TILES << 4)) {
+        return 0;
+    }
+    return TILE_IS_SOLID(currentMap[(xPixel >> 4) + ((yPixel - HUD_PIXEL_HEIGHT) & 0xf0)]);
+}
+
+// Tests the 4 corners of a box given in the game's extended (8.8 fixed point; 8 bits of sub-pixel) coordinates.
+static unsigned char is_solid_box(long left, long top, long right, long bottom) {
+    left >>= PLAYER_POSITION_SHIFT;
+    top >>= PLAYER_POSITION_SHIFT;
+    right >>= PLAYER_POSITION_SHIFT;
+    bottom >>= PLAYER_POSITION_SHIFT;
+    return is_solid_pixel(left, top) || is_solid_pixel(right, top) || is_solid_pixel(left, bottom) || is_solid_pixel(right, bottom);
+}
+
+// The player's collision box, same as test_player_tile_collision in player.c uses.
+static void check_player(void) {
+    long left = playerXPosition + PLAYER_X_OFFSET_EXTENDED,
+        top = playerYPosition + PLAYER_Y_OFFSET_EXTENDED;
+
+    if (is_solid_box(left, top, left + PLAYER_WIDTH_EXTENDED, top + PLAYER_HEIGHT_EXTENDED)) {
+        report("Player is inside of a solid tile");
+    }
+}
+
+// Moving sprites keep their tile hitbox (spriteTileHitboxLeft and friends, from the sprite definition) clear of solid
+// tiles. (See the movement functions in map_sprites.c) Sprites that never move can be placed anywhere in the map
+// editor, so we skip those.
+static void check_map_sprites(void) {
+    unsigned char spriteIndex;
+    char message[64];
+    long sprX, sprY;
+    for (spriteIndex = 0; spriteIndex != MAP_SPRITE_SLOT_COUNT; ++spriteIndex) {
+        unsigned char *sprite = &currentMapSpriteData[spriteIndex << MAP_SPRITE_DATA_SHIFT];
+        if (sprite[MAP_SPRITE_DATA_POS_TYPE] == SPRITE_TYPE_OFFSCREEN ||
+                sprite[MAP_SPRITE_DATA_POS_MOVEMENT_TYPE] == SPRITE_MOVEMENT_NONE) {
+            continue;
+        }
+        sprX = sprite[MAP_SPRITE_DATA_POS_X] + (sprite[MAP_SPRITE_DATA_POS_X + 1] << 8);
+        sprY = sprite[MAP_SPRITE_DATA_POS_Y] + (sprite[MAP_SPRITE_DATA_POS_Y + 1] << 8);
+        if (is_solid_box(
+                sprX + ((long)spriteTileHitboxLeft[spriteIndex] << SPRITE_POSITION_SHIFT),
+                sprY + ((long)spriteTileHitboxTop[spriteIndex] << SPRITE_POSITION_SHIFT),
+                sprX + ((long)spriteTileHitboxRight[spriteIndex] << SPRITE_POSITION_SHIFT),
+                sprY + ((long)spriteTileHitboxBottom[spriteIndex] << SPRITE_POSITION_SHIFT))) {
+            snprintf(message, sizeof(message), "Map sprite %u is inside of a solid tile", spriteIndex);
+            report(message);
+        }
+    }
+}
+
+// The collision bitmap load_map builds has to agree with the tiles in the room, and stay clear below it.
+static void check_collision_map(void) {
+    unsigned short index;
+    for (index = 0; index != (MAP_COLLISION_BYTES << 3); ++index) {
+        unsigned char expected = index < MAP_DATA_TILE_LENGTH && TILE_IS_SOLID(currentMap[index]);
+        if (!MAP_INDEX_IS_SOLID(index) != !expected) {
+            report("Collision bitmap does not match the current map");
+            return;
+        }
+    }
+}
+
+uint32_t host_sim_check_invariants(uint32_t frame) {
+    currentFrame = frame;
+    problemCount = 0;
+
+    // Only check while you can actually play; during transitions things are allowed to be half-way updated.
+    if (gameState != GAME_STATE_RUNNING) {
+        return 0;
+    }
+
+    // Every bank_push needs a bank_pop; by the end of the main loop, we should be back where we started.
+    if (bankLevel != 0) {
+        report("Bank stack is not empty at the end of the frame");
+    }
+
+    check_collision_map();
+    check_player();
+    check_map_sprites();
+
+    if (playerHealth == 0 || playerHealth > playerMaxHealth) {
+        report("Player health is out of range");
+    }
+    if (playerKeyCount > MAX_KEY_COUNT) {
+        report("Player has more keys than MAX_KEY_COUNT");
+    }
+    // Walking off the edge of the world would put the player in a room that doesn't exist.
+    if (playerOverworldPosition >= OVERWORLD_ROOM_COUNT) {
+        report("Player is outside of the world");
+    }
+
+    return problemCount;
+}
+
+void host_sim_describe_state(char *buffer, uint32_t bufferSize) {
+    snprintf(buffer, bufferSize, "state %u, room %u, player at %d,%d, health %u, keys %u",
+        gameState, playerOverworldPosition, playerXPosition >> PLAYER_POSITION_SHIFT, playerYPosition >> PLAYER_POSITION_SHIFT,
+        playerHealth, playerKeyCount);
+}
@@ -0,0 +1,484 @@
+// Stand-ins for neslib, the MMC1 bank helpers, and the bits of crt0 the game uses, for the host simulation build.
+// Instead of talking to the NES hardware, everything lands in plain arrays: OAM, VRAM (the full 16k PPU address
+// space) and the palette. The game code calls these exactly the same way it calls neslib.
+//
+// Where it matters for the game's logic, these behave exactly like the real thing - for example, rand8 gives the same
+// numbers as neslib's, and ppu_wait_frame skips every 6th frame on NTSC, like neslib does.
+
+#include "source/neslib_asm/neslib.h"
+#include "source/library/bank_helpers.h"
+#include "source/menus/error.h"
+#include "source/library/input_recorder.h"
+#include "tools/host_sim/src/host_sim_api.h"
+
+// ===== Hardware state =====
+
+uint8_t hostOam[256];
+uint8_t hostPalette[32];
+uint8_t hostVram[0x4000];
+uint8_t hostPaletteBrightness;
+uint8_t hostPpuMask;
+
+// Normally exported from crt0.asm. The low byte counts up every frame; the high byte counts from 0-5 and starts over.
+unsigned int frameCount;
+
+// The palettes are normally built into the rom by palettes.asm; we load them from the same files at startup.
+unsigned char titlePalette[16];
+unsigned char errorPalette[16];
+unsigned char mainBgPalette[16];
+unsigned char mainSpritePalette[16];
+
+static unsigned int vramAddress;
+static unsigned char vramIncrement = 1;
+static unsigned char *vramUpdateBuffer;
+static unsigned char vramUpdatePending;
+static unsigned char ppuCtrl;
+static unsigned char oamSize;
+static unsigned int scrollX, scrollY;
+static unsigned char randSeed[2] = {0xfd, 0xfd};
+static unsigned char padState[2], padTriggered[2];
+
+static unsigned char currentPrgBank;
+static unsigned char currentChrBank0, currentChrBank1;
+static unsigned char currentMirroring;
+
+// ===== Frames =====
+
+static void write_vram(unsigned char value) {
+    hostVram[vramAddress & 0x3fff] = value;
+    vramAddress += vramIncrement;
+}
+
+// Same format neslib's flush_vram_update reads; see set_vram_update in neslib.h.
+static void apply_vram_update(unsigned char *buf) {
+    unsigned char value, count, increment;
+    unsigned int address;
+    while (1) {
+        value = *buf++;
+        if (value < 0x40) {
+            // Single byte write
+            address = (value << 8) | *buf++;
+            hostVram[address & 0x3fff] = *buf++;
+        } else if (value == NT_UPD_EOF) {
+            return;
+        } else {
+            // A run of bytes, going either across or down.
+            increment = value >= NT_UPD_VERT ? 32 : 1;
+            address = ((value & 0x3f) << 8) | *buf++;
+            count = *buf++;
+            do {
+                hostVram[address & 0x3fff] = *buf++;
+                address += increment;
+            } while (--count);
+        }
+    }
+}
+
+// Does the same things the NMI in neslib does that the game can see, then lets the harness know a frame went by.
+static void nmi(unsigned char mainLoopFrame) {
+    // Like on the NES, nothing gets written to vram if rendering is off.
+    if (hostPpuMask & 0x18) {
+        if (vramUpdatePending && vramUpdateBuffer != NULL) {
+            apply_vram_update(vramUpdateBuffer);
+        }
+        vramUpdatePending = 0;
+    }
+
+    frameCount = (frameCount & 0xff00) | ((frameCount + 1) & 0x00ff);
+    if ((frameCount >> 8) == 5) {
+        frameCount &= 0x00ff;
+    } else {
+        frameCount += 0x0100;
+    }
+
+    host_sim_end_frame(mainLoopFrame);
+}
+
+void __fastcall__ ppu_wait_nmi(void) {
+    vramUpdatePending = 1;
+    nmi(0);
+}
+
+void __fastcall__ ppu_wait_frame(void) {
+    vramUpdatePending = 1;
+    nmi(1);
+    // On NTSC systems, neslib skips every 6th frame so the game runs at the same speed as on PAL.
+    while ((frameCount >> 8) == 5) {
+        nmi(0);
+    }
+}
+
+void __fastcall__ delay(unsigned char frames) {
+    do {
+        ppu_wait_nmi();
+    } while (--frames);
+}
+
+// Does what crt0 does between power on and calling main(), as far as the game can tell: it waits a frame, then
+// turns the ppu off. (The rest of memory starts out cleared, just like crt0 leaves it.)
+void host_sim_power_on(void) {
+    ppuCtrl = 0x80;
+    hostPpuMask = 0x06;
+    ppu_wait_nmi();
+    ppu_off();
+}
+
+unsigned char __fastcall__ ppu_system(void) {
+    // Always pretend to be an NTSC system.
+    return 0x80;
+}
+
+void __fastcall__ ppu_off(void) {
+    hostPpuMask &= 0xe7;
+    ppu_wait_nmi();
+}
+
+void __fastcall__ ppu_on_all(void) {
+    hostPpuMask |= 0x18;
+    ppu_wait_nmi();
+}
+
+void __fastcall__ ppu_on_bg(void) {
+    hostPpuMask |= 0x08;
+    ppu_wait_nmi();
+}
+
+void __fastcall__ ppu_on_spr(void) {
+    hostPpuMask |= 0x10;
+    ppu_wait_nmi();
+}
+
+void __fastcall__ ppu_mask(unsigned char mask) {
+    hostPpuMask = mask;
+}
+
+// ===== Palettes =====
+
+void __fastcall__ pal_all(const char *data) {
+    nes_memcpy(hostPalette, (void*)data, 32);
+}
+
+void __fastcall__ pal_bg(const char *data) {
+    nes_memcpy(hostPalette, (void*)data, 16);
+}
+
+void __fastcall__ pal_spr(const char *data) {
+    nes_memcpy(hostPalette + 16, (void*)data, 16);
+}
+
+void __fastcall__ pal_col(unsigned char index, unsigned char color) {
+    hostPalette[index & 0x1f] = color;
+}
+
+void __fastcall__ pal_clear(void) {
+    nes_memfill(hostPalette, 0x0f, 32);
+}
+
+// We only keep a single brightness for the whole palette; the game always sets both at once anyway.
+void __fastcall__ pal_bright(unsigned char bright) {
+    hostPaletteBrightness = bright;
+}
+
+void __fastcall__ pal_spr_bright(unsigned char bright) {
+    hostPaletteBrightness = bright;
+}
+
+void __fastcall__ pal_bg_bright(unsigned char bright) {
+    hostPaletteBrightness = bright;
+}
+
+static int load_palette(const char *folder, const char *name, unsigned char *palette) {
+    char path[512];
+    FILE *file;
+    snprintf(path, sizeof(path), "%s/%s", folder, name);
+    file = fopen(path, "rb");
+    if (file == NULL || fread(palette, 1, 16, file) != 16) {
+        fprintf(stderr, "[host_sim] Could not read palette file %s\n", path);
+        if (file != NULL) {
+            fclose(file);
+        }
+        return 1;
+    }
+    fclose(file);
+    return 0;
+}
+
+// These match the .incbin lines in source/graphics/palettes.asm.
+int host_sim_load_palettes(const char *paletteFolder) {
+    return load_palette(paletteFolder, "title.pal", titlePalette) ||
+        load_palette(paletteFolder, "error.pal", errorPalette) ||
+        load_palette(paletteFolder, "main_bg.pal", mainBgPalette) ||
+        load_palette(paletteFolder, "main_sprite.pal", mainSpritePalette);
+}
+
+// ===== Sprites =====
+
+void __fastcall__ oam_clear(void) {
+    unsigned char i = 0;
+    do {
+        hostOam[i] = 0xff;
+        i += 4;
+    } while (i);
+}
+
+void __fastcall__ oam_size(unsigned char size) {
+    oamSize = size;
+}
+
+unsigned char __fastcall__ oam_spr(unsigned char x, unsigned char y, unsigned char chrnum, unsigned char attr, unsigned char sprid) {
+    hostOam[sprid] = y;
+    hostOam[sprid + 1] = chrnum;
+    hostOam[sprid + 2] = attr;
+    hostOam[sprid + 3] = x;
+    return sprid + 4;
+}
+
+unsigned char __fastcall__ oam_meta_spr(unsigned char x, unsigned char y, unsigned char sprid, const unsigned char *data) {
+    while (data[0] != 0x80) {
+        hostOam[sprid + 3] = data[0] + x;
+        hostOam[sprid] = data[1] + y;
+        hostOam[sprid + 1] = data[2];
+        hostOam[sprid + 2] = data[3];
+        sprid += 4;
+        data += 4;
+    }
+    return sprid;
+}
+
+void __fastcall__ oam_hide_rest(unsigned char sprid) {
+    do {
+        hostOam[sprid] = 240;
+        sprid += 4;
+    } while (sprid);
+}
+
+// ===== Sound =====
+// Sound is not simulated; the game doesn't look at anything the sound engine does.
+
+void __fastcall__ music_play(unsigned char song) {
+}
+
+void __fastcall__ music_stop(void) {
+}
+
+void __fastcall__ music_pause(unsigned char pause) {
+}
+
+void __fastcall__ sfx_play(unsigned char sound, unsigned char channel) {
+}
+
+// ===== Controllers =====
+
+unsigned char __fastcall__ pad_poll(unsigned char pad) {
+    unsigned char lastState = padState[pad & 0x01];
+    padState[pad & 0x01] = (pad & 0x01) ? 0 : host_sim_next_input();
+    padTriggered[pad & 0x01] = (padState[pad & 0x01] ^ lastState) & padState[pad & 0x01];
+    return padState[pad & 0x01];
+}
+
+unsigned char __fastcall__ pad_trigger(unsigned char pad) {
+    pad_poll(pad);
+    return padTriggered[pad & 0x01];
+}
+
+unsigned char __fastcall__ pad_state(unsigned char pad) {
+    return padState[pad & 0x01];
+}
+
+// ===== Input recorder =====
+// The host simulation is built with INPUT_REPLAY, and takes the place of input_recorder.c: the harness decides what
+// gets pressed, and can hand the game the random seed from a recording.
+
+unsigned char inputReplayFinished;
+
+void input_recorder_init(void) {
+}
+
+unsigned char __fastcall__ input_pad_poll(unsigned char pad) {
+    return pad_poll(pad);
+}
+
+unsigned int __fastcall__ input_random_seed(unsigned int seed) {
+    return host_sim_random_seed(seed);
+}
+
+void input_recorder_stop(void) {
+}
+
+// ===== Scrolling and chr banks =====
+
+void __fastcall__ scroll(unsigned int x, unsigned int y) {
+    scrollX = x;
+    scrollY = y;
+}
+
+// split waits for sprite 0 to be hit partway down the screen; there's no screen here, so just do the scroll.
+void __fastcall__ split(unsigned int x, unsigned int y) {
+    scrollX = x;
+}
+
+void __fastcall__ split_y(unsigned int x, unsigned int y) {
+    scrollX = x;
+    scrollY = y;
+}
+
+void __fastcall__ bank_spr(unsigned char n) {
+    ppuCtrl = (ppuCtrl & 0xf7) | ((n & 0x01) << 3);
+}
+
+void __fastcall__ bank_bg(unsigned char n) {
+    ppuCtrl = (ppuCtrl & 0xef) | ((n & 0x01) << 4);
+}
+
+// ===== Random numbers =====
+// These are the same galois generators neslib uses, so the game gets the same numbers from the same seed.
+
+static unsigned char rand1(void) {
+    randSeed[0] = (randSeed[0] & 0x80) ? ((randSeed[0] << 1) ^ 0xcf) : (randSeed[0] << 1);
+    return randSeed[0];
+}
+
+// Also returns the carry flag from the shift, since rand8 adds it in.
+static unsigned char rand2(unsigned char *carry) {
+    *carry = (randSeed[1] & 0x80) ? 1 : 0;
+    randSeed[1] = *carry ? ((randSeed[1] << 1) ^ 0xd7) : (randSeed[1] << 1);
+    return randSeed[1];
+}
+
+unsigned char __fastcall__ rand8(void) {
+    unsigned char carry;
+    rand1();
+    return rand2(&carry) + randSeed[0] + carry;
+}
+
+unsigned int __fastcall__ rand16(void) {
+    unsigned char carry;
+    unsigned char high = rand1();
+    return (high << 8) | rand2(&carry);
+}
+
+void __fastcall__ set_rand(unsigned int seed) {
+    randSeed[0] = seed & 0xff;
+    randSeed[1] = seed >> 8;
+}
+
+// ===== VRAM =====
+
+void __fastcall__ set_vram_update(unsigned char *buf) {
+    vramUpdateBuffer = buf;
+}
+
+void __fastcall__ flush_vram_update(unsigned char *buf) {
+    apply_vram_update(buf);
+}
+
+void __fastcall__ vram_adr(unsigned int adr) {
+    vramAddress = adr;
+}
+
+void __fastcall__ vram_put(unsigned char n) {
+    write_vram(n);
+}
+
+void __fastcall__ vram_fill(unsigned char n, unsigned int len) {
+    while (len--) {
+        write_vram(n);
+    }
+}
+
+void __fastcall__ vram_inc(unsigned char n) {
+    vramIncrement = n ? 32 : 1;
+}
+
+void __fastcall__ vram_read(unsigned char *dst, unsigned int size) {
+    while (size--) {
+        *dst++ = hostVram[vramAddress & 0x3fff];
+        vramAddress += vramIncrement;
+    }
+}
+
+void __fastcall__ vram_write(unsigned char *src, unsigned int size) {
+    while (size--) {
+        write_vram(*src++);
+    }
+}
+
+// Same format as neslib's vram_unrle: the first byte is a tag. The tag followed by a count repeats the last byte that
+// many times; a count of 0 ends the data.
+void __fastcall__ vram_unrle(const unsigned char *data) {
+    unsigned char tag = *data++, value = 0, count;
+    while (1) {
+        if (*data != tag) {
+            value = *data++;
+            write_vram(value);
+            continue;
+        }
+        ++data;
+        count = *data++;
+        if (count == 0) {
+            return;
+        }
+        while (count--) {
+            write_vram(value);
+        }
+    }
+}
+
+// ===== Memory =====
+
+void __fastcall__ memcpy(void *dst, void *src, unsigned int len) {
+    unsigned char *d = dst, *s = src;
+    while (len--) {
+        *d++ = *s++;
+    }
+}
+
+void __fastcall__ memfill(void *dst, unsigned char value, unsigned int len) {
+    unsigned char *d = dst;
+    while (len--) {
+        *d++ = value;
+    }
+}
+
+// ===== Reset and crashes =====
+
+void __fastcall__ reset(void) {
+    host_sim_end_episode("reset");
+}
+
+// Replaces crash_error in error.c (which is built renamed, so it never runs) - there's no screen to show the error
+// on, so we print it out instead.
+void crash_error(const char *errorId, const char *errorDescription, const char *numberName, int number) {
+    static char message[512];
+    if (numberName != NULL) {
+        snprintf(message, sizeof(message), "crash_error: %s - %s (%s: %d)", errorId, errorDescription, numberName, number);
+    } else {
+        snprintf(message, sizeof(message), "crash_error: %s - %s", errorId, errorDescription);
+    }
+    host_sim_end_episode(message);
+}
+
+// ===== MMC1 =====
+// There's only one big address space here, so switching banks doesn't do anything besides remember the bank.
+
+unsigned char __fastcall__ set_prg_bank(unsigned char bank_id) {
+    unsigned char oldBank = currentPrgBank;
+    currentPrgBank = bank_id;
+    return oldBank;
+}
+
+unsigned char __fastcall__ get_prg_bank(void) {
+    return currentPrgBank;
+}
+
+void __fastcall__ set_chr_bank_0(unsigned char bank_id) {
+    currentChrBank0 = bank_id;
+}
+
+void __fastcall__ set_chr_bank_1(unsigned char bank_id) {
+    currentChrBank1 = bank_id;
+}
+
+void __fastcall__ set_mirroring(unsigned char mirroring) {
+    currentMirroring = mirroring;
+}
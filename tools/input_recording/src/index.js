@@ -0,0 +1,158 @@
+/**
+ * Converts input recordings (made with INPUT_MODE=record in the makefile) between the .sav files emulators write
+ * out, and a simple text format you can read, edit, and keep in git.
+ *
+ * The text format has one line per run of button presses: how many controller reads it lasts, then the buttons held,
+ * joined with +. (Or - for no buttons) For example:
+ *
+ *     seed 1234
+ *     60 -
+ *     1 START
+ *     45 RIGHT
+ *     3 A+RIGHT
+ *
+ * Lines starting with # are ignored. The layout matches source/library/input_recorder.h.
+ *
+ * This tool has no dependencies outside of nodejs itself, so it can run anywhere node can.
+ */
+var VERSION = require('./package.json').version;
+
+var fs = require('fs'),
+    command = process.argv[2],
+    // Size of the .sav file emulators expect for 8k of WRAM.
+    SAV_SIZE = 0x2000,
+    MAGIC = [0x49, 0x52], // 'I', 'R'
+    RECORDING_VERSION = 1,
+    POS_VERSION = 2,
+    POS_STATUS = 3,
+    POS_SEED = 4,
+    POS_RUN_COUNT = 6,
+    HEADER_SIZE = 8,
+    STATUS_FINISHED = 1,
+    // Same order as the PAD_ constants in neslib.h - bit 0 is A.
+    BUTTONS = ['A', 'B', 'SELECT', 'START', 'UP', 'DOWN', 'LEFT', 'RIGHT'];
+
+function printDate() {
+    return '[' + new Date().toUTCString() + '] ';
+}
+
+function printUsage() {
+    out('input_recording version ' + VERSION);
+    out('Usage: input_recording dump [path/to/game.sav] [path/to/recording.txt]');
+    out('       input_recording pack [path/to/recording.txt] [path/to/game.sav] [offset in WRAM, default 0]');
+}
+
+function out() {
+    var args = [].slice.call(arguments);
+    args.unshift('[input_recording] ', printDate());
+
+    console.info.apply(this, args);
+}
+
+function fail(message) {
+    out('ERROR: ' + message);
+    process.exit(1);
+}
+
+function buttonsToText(buttons) {
+    var names = BUTTONS.filter(function(name, bit) { return buttons & (1 << bit); });
+    return names.length ? names.join('+') : '-';
+}
+
+function textToButtons(text, lineNumber) {
+    if (text == '-') {
+        return 0;
+    }
+    return text.split('+').reduce(function(buttons, name) {
+        var bit = BUTTONS.indexOf(name.toUpperCase());
+        if (bit === -1) {
+            fail('Unknown button "' + name + '" on line ' + lineNumber + '. Use one of: ' + BUTTONS.join(', '));
+        }
+        return buttons | (1 << bit);
+    }, 0);
+}
+
+// The recording can be anywhere in WRAM, depending on what else the game puts there. Find it by its header.
+function findRecording(data) {
+    for (var i = 0; i + HEADER_SIZE <= data.length; i++) {
+        if (data[i] == MAGIC[0] && data[i+1] == MAGIC[1] && data[i+POS_VERSION] == RECORDING_VERSION) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+function dump(savFile, textFile) {
+    var data = fs.readFileSync(savFile),
+        start = findRecording(data);
+    if (start === -1) {
+        fail('No input recording found in ' + savFile + '. Was the game built with INPUT_MODE=record?');
+    }
+
+    var runCount = data.readUInt16LE(start + POS_RUN_COUNT),
+        lines = [
+            '# Input recording from ' + savFile + (data[start + POS_STATUS] == STATUS_FINISHED ? '' : ' (not finished)'),
+            '# Each line is: number of controller reads, then the buttons held.',
+            'seed ' + data.readUInt16LE(start + POS_SEED)
+        ],
+        totalReads = 0;
+    for (var i = 0; i < runCount; i++) {
+        var pos = start + HEADER_SIZE + (i * 2);
+        lines.push(data[pos] + ' ' + buttonsToText(data[pos + 1]));
+        totalReads += data[pos];
+    }
+    fs.writeFileSync(textFile, lines.join('\n') + '\n');
+    out('Wrote ' + runCount + ' runs (' + totalReads + ' frames of input) to ' + textFile);
+}
+
+function pack(textFile, savFile, offset) {
+    var runs = [],
+        seed = 0;
+    fs.readFileSync(textFile).toString().split(/\r?\n/).forEach(function(line, index) {
+        line = line.trim();
+        if (line === '' || line.indexOf('#') === 0) {
+            return;
+        }
+        var parts = line.split(/\s+/);
+        if (parts[0] == 'seed') {
+            seed = parseInt(parts[1], 10);
+            return;
+        }
+        var count = parseInt(parts[0], 10),
+            buttons = textToButtons(parts[1] || '-', index + 1);
+        if (isNaN(count) || count < 1) {
+            fail('Expected a number of reads at the start of line ' + (index + 1) + ', got "' + parts[0] + '"');
+        }
+        // Runs can be at most 255 reads long, so split up anything longer.
+        while (count > 0) {
+            runs.push([Math.min(count, 255), buttons]);
+            count -= 255;
+        }
+    });
+
+    var data = Buffer.alloc(SAV_SIZE, 0);
+    if (offset + HEADER_SIZE + (runs.length * 2) > SAV_SIZE) {
+        fail('Recording is too big to fit in WRAM. (' + runs.length + ' runs)');
+    }
+    data[offset] = MAGIC[0];
+    data[offset + 1] = MAGIC[1];
+    data[offset + POS_VERSION] = RECORDING_VERSION;
+    data[offset + POS_STATUS] = STATUS_FINISHED;
+    data.writeUInt16LE(seed, offset + POS_SEED);
+    data.writeUInt16LE(runs.length, offset + POS_RUN_COUNT);
+    runs.forEach(function(run, i) {
+        data[offset + HEADER_SIZE + (i * 2)] = run[0];
+        data[offset + HEADER_SIZE + (i * 2) + 1] = run[1];
+    });
+    fs.writeFileSync(savFile, data);
+    out('Wrote ' + runs.length + ' runs to ' + savFile);
+}
+
+if (command == 'dump' && process.argv.length == 5) {
+    dump(process.argv[3], process.argv[4]);
+} else if (command == 'pack' && (process.argv.length == 5 || process.argv.length == 6)) {
+    pack(process.argv[3], process.argv[4], process.argv.length == 6 ? Number(process.argv[5]) : 0);
+} else {
+    printUsage();
+    process.exit(1);
+}
@@ -0,0 +1,324 @@
+/**
+ * Reads the map and debug files written by ld65, and prints out how full each bank of the rom is, as well as
+ * how much ram and zeropage we use. It also lists the biggest things in each bank, since that's usually the
+ * first thing you want to know when a bank fills up.
+ *
+ * This replaces NES Space Checker (nessc) for our purposes, since that is windows-only. This tool has no
+ * dependencies outside of nodejs itself, so it can run anywhere node can.
+ *
+ * If any memory area goes over the limit set for it, the tool exits with an error, which stops the build.
+ */
+var VERSION = require('./package.json').version;
+
+// Expects at least the three files (first two params are always node and the script)
+if (process.argv.length < 5) {
+    printUsage();
+    process.exit(1);
+}
+
+var fs = require('fs'),
+    logLevel = 'info', // change to 'verbose' for some extra output
+    configFile = process.argv[2],
+    mapFile = process.argv[3],
+    debugFile = process.argv[4],
+    limitArgs = process.argv.slice(5),
+    // How many of the largest symbols to list for each memory area.
+    LARGEST_SYMBOL_COUNT = 5,
+    // Memory areas we report as ROM, in the order we want to show them.
+    ROM_AREAS = ['ROM_00', 'ROM_01', 'ROM_02', 'ROM_03', 'ROM_04', 'ROM_05', 'ROM_06', 'PRG', 'DMC'],
+    // Memory areas we report as RAM. (WRAM only shows up if something uses it)
+    RAM_AREAS = ['ZP', 'RAM', 'WRAM'];
+
+function printDate() {
+    return '[' + new Date().toUTCString() + '] ';
+}
+
+function printUsage() {
+    out('rom_budget version ' + VERSION);
+    out('Usage: rom_budget [path/to/game.cfg] [path/to/rom.map] [path/to/rom.dbg] [limits...]');
+    out('Limits are given as AREA=percent, for example: ROM_02=90 RAM=85. Use ALL=percent to set the default.');
+}
+
+function out() {
+    var args = [].slice.call(arguments);
+    args.unshift('[rom_budget] ', printDate());
+
+    console.info.apply(this, args);
+}
+
+function verbose() {
+    var args = [].slice.call(arguments);
+    args.unshift('[rom_budget] ', printDate());
+
+    if (logLevel == 'verbose') {
+        console.info.apply(this, args);
+    }
+}
+
+// ld65 config values can be written as $hex, 0xhex, or decimal.
+function parseNumber(str) {
+    str = str.trim();
+    if (str.indexOf('$') === 0) {
+        return parseInt(str.substr(1), 16);
+    } else if (str.indexOf('0x') === 0) {
+        return parseInt(str.substr(2), 16);
+    }
+    return parseInt(str, 10);
+}
+
+function padRight(str, len) {
+    str = String(str);
+    while (str.length < len) {
+        str += ' ';
+    }
+    return str;
+}
+
+function padLeft(str, len) {
+    str = String(str);
+    while (str.length < len) {
+        str = ' ' + str;
+    }
+    return str;
+}
+
+// Pulls a block like `MEMORY { ... }` out of the linker config, and turns every `NAME: a = b, c = d;` line into
+// an object of {a: 'b', c: 'd'}, keyed by name.
+function parseConfigBlock(configText, blockName) {
+    var blockStart = configText.search(new RegExp('\\b' + blockName + '\\s*\\{')),
+        entries = {};
+    if (blockStart === -1) {
+        return entries;
+    }
+    var blockText = configText.substr(configText.indexOf('{', blockStart) + 1);
+    blockText = blockText.substr(0, blockText.indexOf('}'));
+
+    blockText.split(';').forEach(function(line) {
+        var nameMatch = line.match(/^\s*([A-Za-z0-9_]+)\s*:([\s\S]*)$/);
+        if (!nameMatch) {
+            return;
+        }
+        var attributes = {};
+        nameMatch[2].split(',').forEach(function(attr) {
+            var parts = attr.split('=');
+            if (parts.length == 2) {
+                attributes[parts[0].trim()] = parts[1].trim();
+            }
+        });
+        entries[nameMatch[1]] = attributes;
+    });
+    return entries;
+}
+
+// Reads the "Segment list" and "Modules list" sections of the ld65 map file.
+function parseMapFile(mapText) {
+    var lines = mapText.split(/\r?\n/),
+        section = null,
+        currentModule = null,
+        result = {segments: {}, modules: []};
+
+    lines.forEach(function(line) {
+        if (line.indexOf('Modules list:') === 0) {
+            section = 'modules';
+            return;
+        } else if (line.indexOf('Segment list:') === 0) {
+            section = 'segments';
+            return;
+        } else if (/^[A-Za-z].* list/.test(line)) {
+            section = null;
+            return;
+        }
+
+        if (section == 'modules') {
+            // Module names are not indented, their segments are. Segment lines look like either of these, depending on ld65 version:
+            //     CODE              Offs=000000  Size=000010  Align=00001  Fill=0000
+            //     CODE              Offs = 000000   Size = 000010
+            var segmentMatch = line.match(/^\s+([A-Za-z0-9_]+)\s+Offs\s*=\s*([0-9A-Fa-f]+)\s+Size\s*=\s*([0-9A-Fa-f]+)/);
+            if (segmentMatch && currentModule) {
+                result.modules.push({module: currentModule, segment: segmentMatch[1], size: parseInt(segmentMatch[3], 16)});
+            } else if (/^\S.*:\s*$/.test(line)) {
+                currentModule = line.replace(/:\s*$/, '');
+            }
+        } else if (section == 'segments') {
+            // Name                   Start     End    Size  Align
+            var match = line.match(/^([A-Za-z0-9_]+)\s+([0-9A-Fa-f]{6})\s+([0-9A-Fa-f]{6})\s+([0-9A-Fa-f]{6})/);
+            if (match) {
+                result.segments[match[1]] = {name: match[1], start: parseInt(match[2], 16), size: parseInt(match[4], 16)};
+            }
+        }
+    });
+    return result;
+}
+
+// Reads symbols out of the ld65 debug file, and guesses their sizes based on the distance to the next symbol in
+// the same segment. Only top-level symbols are used; labels inside of functions would otherwise split them up.
+function parseDebugFile(debugText) {
+    var segments = {},
+        scopes = {},
+        symbols = [];
+
+    debugText.split(/\r?\n/).forEach(function(line) {
+        var typeMatch = line.match(/^(\w+)\s+(.*)$/);
+        if (!typeMatch) {
+            return;
+        }
+        var attributes = {};
+        // Values can be quoted strings with commas in them, so we can't just split on commas.
+        typeMatch[2].replace(/(\w+)=("[^"]*"|[^,]*)/g, function(all, key, value) {
+            attributes[key] = value.replace(/^"|"$/g, '');
+        });
+
+        if (typeMatch[1] == 'seg') {
+            segments[attributes.id] = {name: attributes.name, start: parseNumber(attributes.start), size: parseNumber(attributes.size)};
+        } else if (typeMatch[1] == 'scope') {
+            scopes[attributes.id] = attributes;
+        } else if (typeMatch[1] == 'sym' && attributes.type == 'lab' && attributes.seg !== undefined && attributes.parent === undefined) {
+            symbols.push(attributes);
+        }
+    });
+
+    var bySegment = {};
+    symbols.forEach(function(sym) {
+        // Skip anything nested inside of a function or other scope.
+        if (scopes[sym.scope] && scopes[sym.scope].parent !== undefined) {
+            return;
+        }
+        var segment = segments[sym.seg];
+        if (!segment) {
+            return;
+        }
+        if (!bySegment[segment.name]) {
+            bySegment[segment.name] = {segment: segment, symbols: []};
+        }
+        bySegment[segment.name].symbols.push({name: sym.name, value: parseNumber(sym.val), size: sym.size !== undefined ? parseInt(sym.size, 10) : null});
+    });
+
+    var sizedSymbols = [];
+    Object.keys(bySegment).forEach(function(segmentName) {
+        var entry = bySegment[segmentName],
+            list = entry.symbols.sort(function(a, b) { return a.value - b.value; }),
+            segmentEnd = entry.segment.start + entry.segment.size;
+        for (var i = 0; i < list.length; i++) {
+            var size = list[i].size;
+            if (size === null) {
+                size = (i + 1 < list.length ? list[i+1].value : segmentEnd) - list[i].value;
+            }
+            sizedSymbols.push({name: list[i].name, segment: segmentName, size: size});
+        }
+    });
+    return sizedSymbols;
+}
+
+function parseLimits(args) {
+    var limits = {'ALL': 100};
+    args.forEach(function(arg) {
+        var parts = arg.split('=');
+        if (parts.length != 2 || isNaN(parseFloat(parts[1]))) {
+            out('WARNING: Ignoring limit "' + arg + '" - limits look like ROM_02=90');
+            return;
+        }
+        limits[parts[0]] = parseFloat(parts[1]);
+    });
+    return limits;
+}
+
+var configText = fs.readFileSync(configFile).toString().replace(/#.*$/gm, ''),
+    memoryAreas = parseConfigBlock(configText, 'MEMORY'),
+    segmentConfig = parseConfigBlock(configText, 'SEGMENTS'),
+    mapData = parseMapFile(fs.readFileSync(mapFile).toString()),
+    symbols = [],
+    limits = parseLimits(limitArgs),
+    overBudget = [];
+
+if (fs.existsSync(debugFile)) {
+    symbols = parseDebugFile(fs.readFileSync(debugFile).toString());
+} else {
+    out('WARNING: No debug file found at ' + debugFile + ' - listing the largest modules instead of symbols.');
+}
+
+// Figure out which memory area each segment counts against. Segments copied to ram (like DATA) count against both.
+var areaSegments = {};
+Object.keys(segmentConfig).forEach(function(segmentName) {
+    var config = segmentConfig[segmentName],
+        areas = [config.load];
+    if (config.run && config.run != config.load) {
+        areas.push(config.run);
+    }
+    areas.forEach(function(area) {
+        if (!areaSegments[area]) {
+            areaSegments[area] = [];
+        }
+        areaSegments[area].push(segmentName);
+    });
+});
+
+function reportArea(areaName) {
+    var area = memoryAreas[areaName];
+    if (!area) {
+        verbose('Memory area ' + areaName + ' not found in config; skipping.');
+        return;
+    }
+    var size = parseNumber(area.size),
+        segmentNames = areaSegments[areaName] || [],
+        used = 0,
+        segmentDetails = [];
+
+    segmentNames.forEach(function(segmentName) {
+        var segment = mapData.segments[segmentName];
+        if (segment && segment.size > 0) {
+            used += segment.size;
+            segmentDetails.push(segmentName + ' ' + segment.size);
+        }
+    });
+
+    // Most games never touch WRAM, so don't clutter the report with it.
+    if (areaName == 'WRAM' && used === 0) {
+        return;
+    }
+
+    var percent = size ? (used * 100 / size) : 0,
+        limit = limits[areaName] !== undefined ? limits[areaName] : limits['ALL'];
+
+    console.info(
+        padRight(areaName, 8) + padLeft(used, 6) + ' / ' + padLeft(size, 5) + ' bytes ' +
+        padLeft(percent.toFixed(1), 5) + '% used, ' + padLeft(size - used, 5) + ' free' +
+        (percent > limit ? '  ** OVER LIMIT OF ' + limit + '% **' : '')
+    );
+    if (segmentDetails.length > 1) {
+        console.info('    Segments: ' + segmentDetails.join(', '));
+    }
+
+    // Now find the largest things in this area - either symbols from the debug file, or modules from the map.
+    var contents = [];
+    if (symbols.length) {
+        contents = symbols.filter(function(sym) { return segmentNames.indexOf(sym.segment) !== -1; });
+    } else {
+        contents = mapData.modules.filter(function(mod) { return segmentNames.indexOf(mod.segment) !== -1; })
+            .map(function(mod) { return {name: mod.module, size: mod.size}; });
+    }
+    contents.sort(function(a, b) { return b.size - a.size; });
+    contents.slice(0, LARGEST_SYMBOL_COUNT).forEach(function(item) {
+        if (item.size > 0) {
+            console.info('    ' + padLeft(item.size, 6) + '  ' + item.name);
+        }
+    });
+
+    if (percent > limit) {
+        overBudget.push(areaName);
+    }
+}
+
+console.info('');
+console.info('===== ROM usage =====');
+ROM_AREAS.forEach(reportArea);
+console.info('');
+console.info('===== RAM usage =====');
+RAM_AREAS.forEach(reportArea);
+console.info('');
+
+if (overBudget.length) {
+    out('ERROR: The following memory areas are over their limit: ' + overBudget.join(', '));
+    out('Move some code or data to another bank, or raise the limit in the makefile (SPACE_CHECK_LIMITS).');
+    process.exit(1);
+}
+out('All memory areas are within their limits.');
@@ -9,8 +9,8 @@
  */
 var VERSION = require('./package.json').version;
 
-// Expects exactly the number of params we expect (first param is always node)
-if (process.argv.length != 6) {
+// Expects exactly the number of params we expect (first param is always node) The animation image is optional.
+if (process.argv.length != 6 && process.argv.length != 7) {
     printUsage();
     process.exit(1);
 }
@@ -113,8 +113,16 @@ var fs = require('fs'),
     spriteChrFile = process.argv[3],
     spritePalFile = process.argv[4],
     spriteOutFile = process.argv[5],
+    animationOutFile = process.argv[6],
+    // How many bytes each sprite definition has.
+    SPRITE_DEFINITION_LENGTH = 16,
     TILE_ID_OFFSET = 1,
     PALETTE_OFFSET = 2,
+    ANIMATION_OFFSET = 3,
+    // Size of each frame in the animation image. Frames are drawn at the top, with the duration written under them.
+    ANIMATION_CELL_WIDTH = 24,
+    ANIMATION_CELL_HEIGHT = 32,
+    ANIMATION_MAX_FRAMES = 16,
     SCREEN_WIDTH = 16,
     SCREEN_HEIGHT = 12,
     SCREEN_HEIGHT_PADDED = 16,
@@ -126,7 +134,7 @@ function printDate() {
 
 function printUsage() {
     out('sprite_def2img version ' + VERSION);
-    out('Usage: sprite_def2img [path/to/sprite_definitions.c] [path/to/main_sprite.chr] [path/to/main_sprite.pal] [path/to/output.png]');
+    out('Usage: sprite_def2img [path/to/sprite_definitions.c] [path/to/main_sprite.chr] [path/to/main_sprite.pal] [path/to/output.png] [path/to/animations.png (optional)]');
 }
 
 function out() {
@@ -152,6 +160,16 @@ var rawSpriteData = fs.readFileSync(spriteDefFile).toString();
 // Now, strip all comments...
 rawSpriteData = rawSpriteData.replace(/\/\*[\s\S]*?\*\/|([^\\:]|^)\/\/.*$/gm, '$1').trim();
 
+// Keep the whole file around; the animation sequences are in here too.
+var allSpriteData = rawSpriteData;
+
+// We also need sprite_definitions.h for the names of a few constants. It lives right next to sprite_definitions.c.
+var headerFile = path.join(path.dirname(spriteDefFile), 'sprite_definitions.h'),
+    headerText = fs.existsSync(headerFile) ? fs.readFileSync(headerFile).toString() : null;
+if (headerText === null) {
+    out('WARNING: Could not find ' + headerFile + '; constants like SPRITE_HITBOX_16PX and the animation types will not work.');
+}
+
 // Now, find the var we care about...
 var spriteDefinitionTextIndex = rawSpriteData.search(/spriteDefinitions\[\]\s=\s{/);
 if (spriteDefinitionTextIndex === -1) {
@@ -163,21 +181,34 @@ rawSpriteData = rawSpriteData.substr(spriteDefinitionTextIndex);
 rawSpriteData = rawSpriteData.substr(rawSpriteData.indexOf('{') + 1);
 rawSpriteData = rawSpriteData.substr(0, rawSpriteData.indexOf('}'));
 
+// Some constants (like the hitboxes) stand for more than one byte. Swap those out for their values, so every byte is
+// its own entry when we split things up below.
+if (headerText !== null) {
+    var listConstantRegex = /#define[ \t]+(\w+)[ \t]+([^\n]*,[^\n]*)/g,
+        listConstant;
+    while ((listConstant = listConstantRegex.exec(headerText)) !== null) {
+        var listValue = listConstant[2].replace(/\/\/.*$/, '').trim();
+        rawSpriteData = rawSpriteData.replace(new RegExp('\\b' + listConstant[1] + '\\b', 'g'), listValue);
+    }
+}
+
 // Okay, we should just have the var contents now... make it into a js array of strings...
 var strSpriteData = rawSpriteData.split(',').map(function(str) { return str.trim(); });
 
-if (strSpriteData.length % 8 != 0) {
-    out('WARNING: Your sprite data is not a multiple of 8. This will likely break your sprite definitions...');
+if (strSpriteData.length % SPRITE_DEFINITION_LENGTH != 0) {
+    out('WARNING: Your sprite data is not a multiple of ' + SPRITE_DEFINITION_LENGTH + '. This will likely break your sprite definitions...');
 }
-var spriteCount = strSpriteData.length / 8;
+var spriteCount = Math.floor(strSpriteData.length / SPRITE_DEFINITION_LENGTH);
 verbose('Found ' + spriteCount + ' sprites to draw...');
 var parsedSpriteData = [];
 
 // Now go through the sprites one-by-one, and figure out what to do with the values.
 for (var i = 0; i < spriteCount; i++) {
     parsedSpriteData[i] = {baseIndex: i};
-    parsedSpriteData[i].tileIdStr = strSpriteData[i*8 + TILE_ID_OFFSET];
-    parsedSpriteData[i].sizePalStr = strSpriteData[i*8 + PALETTE_OFFSET];
+    parsedSpriteData[i].tileIdStr = strSpriteData[i*SPRITE_DEFINITION_LENGTH + TILE_ID_OFFSET];
+    parsedSpriteData[i].sizePalStr = strSpriteData[i*SPRITE_DEFINITION_LENGTH + PALETTE_OFFSET];
+    parsedSpriteData[i].animationStr = strSpriteData[i*SPRITE_DEFINITION_LENGTH + ANIMATION_OFFSET];
+    parsedSpriteData[i].flipLeft = parsedSpriteData[i].sizePalStr.indexOf('SPRITE_FLIP_LEFT') !== -1;
     
     // Okay, we've got strings. Figure out a radix... is this base 10 (regular num) or base 16 (not)?
     var radix = 10;
@@ -194,6 +225,57 @@ for (var i = 0; i < spriteCount; i++) {
         }
     }
 }
+
+// Next, the animation sequences. These are only needed for the animation image.
+var animationSequences = [];
+if (animationOutFile) {
+    animationSequences = parseAnimationSequences();
+}
+
+// Reads spriteAnimationSequences out of the c file, and splits it up into one list of frames for each animation
+// type. Each frame looks like {frame: 1, duration: 16}.
+function parseAnimationSequences() {
+    var sequenceTextIndex = allSpriteData.search(/spriteAnimationSequences\[\]\s=\s{/);
+    if (sequenceTextIndex === -1) {
+        out('Failed finding spriteAnimationSequences in C file. Bailing out!');
+        process.exit(1);
+    }
+    var sequenceText = allSpriteData.substr(sequenceTextIndex);
+    sequenceText = sequenceText.substr(sequenceText.indexOf('{') + 1);
+    sequenceText = sequenceText.substr(0, sequenceText.indexOf('}'));
+    // SPRITE_ANIMATION_LOOP is a frame with a duration of 0, which ends the sequence.
+    sequenceText = sequenceText.replace(/SPRITE_ANIMATION_LOOP/g, '0, 0');
+
+    var numbers = sequenceText.split(',').map(function(str) { return parseInt(str.trim()); }),
+        sequences = [],
+        currentSequence = [];
+    for (var i = 0; i + 1 < numbers.length; i += 2) {
+        if (numbers[i+1] === 0) {
+            sequences.push(currentSequence);
+            currentSequence = [];
+        } else {
+            currentSequence.push({frame: numbers[i], duration: numbers[i+1]});
+        }
+    }
+    verbose('Found ' + sequences.length + ' animation sequences.');
+    return sequences;
+}
+
+// The animation types are named in the sprite definitions, so we need their numbers from sprite_definitions.h to
+// find their sequences.
+function parseAnimationIds() {
+    var ids = {},
+        match,
+        regex = /#define\s+(SPRITE_ANIMATION_\w+)\s+(\d+)/g;
+    if (headerText === null) {
+        return ids;
+    }
+    while ((match = regex.exec(headerText)) !== null) {
+        ids[match[1]] = parseInt(match[2]);
+    }
+    return ids;
+}
+
 verbose('Finished parsing.. starting to mess with images.');
 
 // Okay, we actually have comprehendible sprite definitions that might even be accurate!
@@ -217,6 +299,82 @@ palettes.forEach(function(pal, idx) {
     rgbPalettes[idx] = [nesToRgb(pal[0]), nesToRgb(pal[1]), nesToRgb(pal[2]), nesToRgb(pal[3])];
 });
 
+// Copy a sprite from the chr image onto another image, starting at the given tile, and color it in with the sprite's
+// palette. If mirror is set, it's flipped left to right, like the NES does for SPRITE_FLIP_LEFT.
+function drawSprite(chrImage, targetImage, tileId, sprite, baseX, baseY, mirror) {
+    targetImage.blit(chrImage, baseX, baseY, Math.floor(tileId%16) * 8, Math.floor(tileId/16)*8, sprite.size, sprite.size);
+    // Okay, we have the right image drawn... BUT, we need to re-color it :(
+    // For every pixel in the image...
+    for (var x = 0; x < sprite.size; x++) {
+        for (var y = 0; y < sprite.size; y++) {
+            // Okay, get the color at this x/y... we just used 0-3 before, which conveniently is our index off rgbPalettes!
+            var color = targetImage.getPixelColor(baseX + x, baseY +y);
+            color = rgbPalettes[sprite.palette][color];
+            // Now write it back out.
+            targetImage.setPixelColor(color, baseX + x, baseY + y);
+        }
+    }
+    if (mirror) {
+        // Swap each pixel with the one across from it on the same row.
+        for (var y = 0; y < sprite.size; y++) {
+            for (var x = 0; x < sprite.size / 2; x++) {
+                var leftColor = targetImage.getPixelColor(baseX + x, baseY + y);
+                targetImage.setPixelColor(targetImage.getPixelColor(baseX + sprite.size - 1 - x, baseY + y), baseX + x, baseY + y);
+                targetImage.setPixelColor(leftColor, baseX + sprite.size - 1 - x, baseY + y);
+            }
+        }
+    }
+}
+
+// Draw every sprite's animation sequence, one sprite per row, with each frame's duration under it. Sprites that can
+// face different directions are drawn facing down. Sprites using SPRITE_FLIP_LEFT also get their mirrored left-facing
+// frames drawn after that, with a gap between, so you can check they look right.
+function drawAnimations(chrImage, font) {
+    var animationIds = parseAnimationIds();
+    new Jimp(ANIMATION_CELL_WIDTH * ANIMATION_MAX_FRAMES, ANIMATION_CELL_HEIGHT * parsedSpriteData.length, function(err, animationImage) {
+        animationImage.rgba(false);
+        animationImage.background(Jimp.rgbaToInt(0, 0, 0, 255));
+
+        for (var i = 0; i < parsedSpriteData.length; i++) {
+            var sprite = parsedSpriteData[i],
+                sequenceId = animationIds[sprite.animationStr] || 0,
+                sequence = animationSequences[sequenceId] || [],
+                offset = sprite.size == 8 ? 4 : 0;
+            if (animationIds[sprite.animationStr] === undefined) {
+                out('WARNING: Unknown animation type "' + sprite.animationStr + '" for sprite ' + i + '; using the first sequence.');
+            }
+            if (sequence.length > ANIMATION_MAX_FRAMES) {
+                out('WARNING: Sprite ' + i + ' has more than ' + ANIMATION_MAX_FRAMES + ' animation frames; only the first ' + ANIMATION_MAX_FRAMES + ' are drawn.');
+            }
+
+            for (var j = 0; j < sequence.length && j < ANIMATION_MAX_FRAMES; j++) {
+                // 16x16 sprites use 2 tiles across for each frame.
+                var tileId = sprite.tileId + (sequence[j].frame * (sprite.size == 16 ? 2 : 1)),
+                    baseX = j * ANIMATION_CELL_WIDTH + offset,
+                    baseY = i * ANIMATION_CELL_HEIGHT + offset;
+                drawSprite(chrImage, animationImage, tileId, sprite, baseX, baseY);
+                animationImage.print(font, j * ANIMATION_CELL_WIDTH, i * ANIMATION_CELL_HEIGHT + 16, String(sequence[j].duration));
+            }
+
+            if (sprite.flipLeft) {
+                // The left-facing frames are the right-facing ones, (0x20 tiles in for 16x16 sprites) mirrored.
+                var firstFlipCell = sequence.length + 1;
+                for (var j = 0; j < sequence.length && firstFlipCell + j < ANIMATION_MAX_FRAMES; j++) {
+                    var tileId = sprite.tileId + (sprite.size == 16 ? 0x20 : 0x10) + (sequence[j].frame * (sprite.size == 16 ? 2 : 1)),
+                        baseX = (firstFlipCell + j) * ANIMATION_CELL_WIDTH + offset,
+                        baseY = i * ANIMATION_CELL_HEIGHT + offset;
+                    drawSprite(chrImage, animationImage, tileId, sprite, baseX, baseY, true);
+                    animationImage.print(font, (firstFlipCell + j) * ANIMATION_CELL_WIDTH, i * ANIMATION_CELL_HEIGHT + 16, String(sequence[j].duration));
+                }
+            }
+        }
+
+        verbose('Writing animation image...');
+        animationImage.write(animationOutFile);
+        out('Success! Animations written to ' + animationOutFile);
+    });
+}
+
 // Create a new image with the chr contents.
 new Jimp(128, 128, function(err, image) {
     image.rgba(false);
@@ -264,18 +422,7 @@ new Jimp(128, 128, function(err, image) {
                     baseX = Math.floor(i%8) * 16 + offset,
                     baseY = Math.floor(i/8) * 16 + offset,
                     lookupId = parsedSpriteData[i].tileId + '_' + parsedSpriteData[i].palette;
-                spriteImage.blit(image, baseX, baseY, Math.floor(parsedSpriteData[i].tileId%16) * 8, Math.floor(parsedSpriteData[i].tileId/16)*8, parsedSpriteData[i].size, parsedSpriteData[i].size);
-                // Okay, we have the right image drawn... BUT, we need to re-color it :(
-                // For every pixel in the image...
-                for (var x = 0; x < parsedSpriteData[i].size; x++) {
-                    for (var y = 0; y < parsedSpriteData[i].size; y++) {
-                        // Okay, get the color at this x/y... we just used 0-3 before, which conveniently is our index off rgbPalettes!
-                        var color = spriteImage.getPixelColor(baseX + x, baseY +y);
-                        color = rgbPalettes[parsedSpriteData[i].palette][color];
-                        // Now write it back out.
-                        spriteImage.setPixelColor(color, baseX + x, baseY + y);
-                    }
-                }
+                drawSprite(image, spriteImage, parsedSpriteData[i].tileId, parsedSpriteData[i], baseX, baseY);
                 if (spriteDuplicateMap[lookupId].totalCount > 1) {
 
                     spriteImage.print(font, baseX - offset + 4, baseY + 1 - offset, String.fromCharCode('A'.charCodeAt(0) + spriteDuplicateMap[lookupId].thisCount));
@@ -289,6 +436,10 @@ new Jimp(128, 128, function(err, image) {
             spriteImage.write(spriteOutFile);
             out('Success! Image written to ' + spriteOutFile);
 
+            if (animationOutFile) {
+                drawAnimations(image, font);
+            }
+
 
         });
     });
@@ -0,0 +1,216 @@
+/**
+ * Turns the sprite scripts in source/sprites/sprite_scripts.txt into C data for the game. Each script becomes a run of
+ * bytes in the spriteScripts array, and gets a SPRITE_SCRIPT_ constant with its id, which sprite_definitions.c uses to
+ * pick a script for a sprite. The game runs them in map_sprites.c; see source/sprites/sprite_scripts.h.
+ *
+ * Labels are turned into positions in spriteScripts here, so the game never has to look anything up by name. This
+ * tool has no dependencies outside of nodejs itself.
+ */
+var VERSION = require('./package.json').version;
+
+// Expects exactly sprite_script infile outfile (first two params are always node and the script)
+if (process.argv.length != 4) {
+    printUsage();
+    process.exit(1);
+}
+
+var fs = require('fs'),
+    logLevel = 'info', // change to 'verbose' for some extra output
+    inFile = process.argv[2],
+    outBase = process.argv[3],
+    // Positions in spriteScripts are one byte, so this is all the room we have.
+    MAX_SCRIPT_BYTES = 256,
+    // spriteDefinitions can't have more than this many sprites in it. (See sprite_definitions.c)
+    MAX_SPRITE_ID = 63,
+    // Every command, and what kind of argument each of its arguments is. The names are turned into the
+    // SPRITE_SCRIPT_OP_ constants from source/sprites/sprite_scripts.h, so they need to match those.
+    COMMANDS = {
+        walk: ['turns'],
+        wait: ['turns'],
+        face: ['direction'],
+        face_player: [],
+        face_random: [],
+        turn_around: [],
+        goto: ['label'],
+        if_wall: ['label'],
+        if_near: ['distance', 'label'],
+        spawn: ['sprite'],
+        remove: []
+    },
+    // Commands that never carry on to the next line. Every script has to end with one of these, or it would run
+    // right into the next script.
+    ENDING_COMMANDS = ['goto', 'remove'],
+    DIRECTIONS = {
+        left: 'SPRITE_DIRECTION_LEFT',
+        right: 'SPRITE_DIRECTION_RIGHT',
+        up: 'SPRITE_DIRECTION_UP',
+        down: 'SPRITE_DIRECTION_DOWN'
+    },
+    NAME_REGEX = /^[A-Za-z_][A-Za-z0-9_]*$/;
+
+function printDate() {
+    return '[' + new Date().toUTCString() + '] ';
+}
+
+function printUsage() {
+    out('sprite_script version ' + VERSION);
+    out('Usage: sprite_script [path/to/sprite_scripts.txt] [file to save output to, no extension]');
+    out('');
+    out(' sprite_script source/sprites/sprite_scripts.txt temp/sprite_scripts');
+}
+
+function out() {
+    var args = [].slice.call(arguments);
+    args.unshift('[sprite_script] ', printDate());
+
+    console.info.apply(this, args);
+}
+
+function verbose() {
+    var args = [].slice.call(arguments);
+    args.unshift('[sprite_script] ', printDate());
+
+    if (logLevel == 'verbose') {
+        console.info.apply(this, args);
+    }
+}
+
+function fail(lineNumber, message) {
+    out('ERROR: ' + inFile + ' line ' + lineNumber + ': ' + message);
+    process.exit(1);
+}
+
+function parseNumber(str, lineNumber, min, max, what) {
+    var value = /^0x[0-9a-f]+$/i.test(str) ? parseInt(str.substr(2), 16) : (/^[0-9]+$/.test(str) ? parseInt(str, 10) : NaN);
+    if (isNaN(value) || value < min || value > max) {
+        fail(lineNumber, what + ' needs to be a number from ' + min + ' to ' + max + '; got "' + str + '"');
+    }
+    return value;
+}
+
+// ===== Reading the scripts =====
+// First pass: split everything up into scripts, labels and commands, and work out where each command will go.
+
+var scripts = [],
+    currentScript = null,
+    position = 0;
+
+fs.readFileSync(inFile, 'utf8').split(/\r?\n/).forEach(function(rawLine, index) {
+    var lineNumber = index + 1,
+        line = rawLine.replace(/(;|\/\/).*$/, '').trim();
+    if (line === '') {
+        return;
+    }
+
+    var scriptMatch = line.match(/^script\s+(\S+)$/);
+    if (scriptMatch) {
+        if (!NAME_REGEX.test(scriptMatch[1])) {
+            fail(lineNumber, '"' + scriptMatch[1] + '" is not a good script name; use letters, numbers and _.');
+        }
+        if (scripts.some(function(script) { return script.name == scriptMatch[1].toUpperCase(); })) {
+            fail(lineNumber, 'There is already a script named ' + scriptMatch[1]);
+        }
+        currentScript = {name: scriptMatch[1].toUpperCase(), lineNumber: lineNumber, start: position, labels: {}, commands: []};
+        scripts.push(currentScript);
+        return;
+    }
+
+    if (currentScript === null) {
+        fail(lineNumber, 'Everything has to be inside a script. Start one with `script name`.');
+    }
+
+    var labelMatch = line.match(/^(\S+):$/);
+    if (labelMatch) {
+        if (!NAME_REGEX.test(labelMatch[1])) {
+            fail(lineNumber, '"' + labelMatch[1] + '" is not a good label name; use letters, numbers and _.');
+        }
+        if (currentScript.labels[labelMatch[1]] !== undefined) {
+            fail(lineNumber, 'There is already a label named ' + labelMatch[1] + ' in this script.');
+        }
+        currentScript.labels[labelMatch[1]] = position;
+        return;
+    }
+
+    var parts = line.split(/[\s,]+/),
+        commandName = parts[0].toLowerCase(),
+        argumentTypes = COMMANDS[commandName];
+    if (argumentTypes === undefined) {
+        fail(lineNumber, 'Unknown command "' + parts[0] + '". The commands are: ' + Object.keys(COMMANDS).join(', '));
+    }
+    if (parts.length - 1 != argumentTypes.length) {
+        fail(lineNumber, commandName + ' needs ' + argumentTypes.length + ' argument(s): ' + (argumentTypes.join(', ') || 'none'));
+    }
+    currentScript.commands.push({name: commandName, args: parts.slice(1), lineNumber: lineNumber, position: position, source: line});
+    position += 1 + argumentTypes.length;
+});
+
+if (scripts.length === 0) {
+    fail(1, 'There are no scripts in this file. Start one with `script name`.');
+}
+if (position > MAX_SCRIPT_BYTES) {
+    out('ERROR: The scripts take up ' + position + ' bytes; they have to fit in ' + MAX_SCRIPT_BYTES + '.');
+    process.exit(1);
+}
+
+// ===== Writing them out =====
+// Second pass: now that we know where every label is, turn each command into bytes.
+
+var scriptData = '';
+scripts.forEach(function(script, id) {
+    var lastCommand = script.commands[script.commands.length - 1];
+    if (!lastCommand) {
+        fail(script.lineNumber, 'Script ' + script.name + ' has no commands in it.');
+    }
+    if (ENDING_COMMANDS.indexOf(lastCommand.name) === -1) {
+        fail(lastCommand.lineNumber, 'Script ' + script.name + ' would run past its end into the next one. Finish it with ' + ENDING_COMMANDS.join(' or ') + '.');
+    }
+
+    scriptData += '    // ' + script.name + ' (id ' + id + ')\n';
+    script.commands.forEach(function(command) {
+        var bytes = ['SPRITE_SCRIPT_OP_' + command.name.toUpperCase()];
+        COMMANDS[command.name].forEach(function(type, index) {
+            var arg = command.args[index];
+            if (type == 'turns') {
+                bytes.push(parseNumber(arg, command.lineNumber, 1, 255, 'The number of turns'));
+            } else if (type == 'distance') {
+                bytes.push(parseNumber(arg, command.lineNumber, 1, 127, 'The distance'));
+            } else if (type == 'sprite') {
+                bytes.push(parseNumber(arg, command.lineNumber, 0, MAX_SPRITE_ID, 'The sprite id'));
+            } else if (type == 'direction') {
+                if (DIRECTIONS[arg.toLowerCase()] === undefined) {
+                    fail(command.lineNumber, 'The direction needs to be one of: ' + Object.keys(DIRECTIONS).join(', '));
+                }
+                bytes.push(DIRECTIONS[arg.toLowerCase()]);
+            } else if (type == 'label') {
+                if (script.labels[arg] === undefined) {
+                    fail(command.lineNumber, 'There is no label named ' + arg + ' in script ' + script.name);
+                }
+                bytes.push(script.labels[arg]);
+            }
+        });
+        scriptData += '    /* ' + command.position + ' */ ' + bytes.join(', ') + ', // ' + command.source + '\n';
+    });
+    verbose('Script ' + script.name + ': ' + script.commands.length + ' commands, starting at ' + script.start);
+});
+// Kill the very last comma
+scriptData = scriptData.replace(/, (\/\/[^\n]*\n)$/, '  $1');
+
+var cData = '// Generated by tools/sprite_script from ' + inFile + '. Edit that file instead of this one!\n' +
+    '#include "source/library/bank_helpers.h"\n' +
+    '#include "source/configuration/system_constants.h"\n' +
+    '#include "source/sprites/sprite_scripts.h"\n\n' +
+    '// The scripts get a unit of their own, so they show up on their own in the space check. They have to share a\n' +
+    '// bank with the code that runs them, though; see tools/cc65_config/bank_affinity.json.\n' +
+    'CODE_BANK(PRG_BANK_SPRITE_SCRIPTS);\n\n' +
+    'const unsigned char spriteScripts[' + position + '] = {\n' + scriptData + '};\n\n' +
+    'const unsigned char spriteScriptStart[' + scripts.length + '] = {\n' +
+    scripts.map(function(script) { return '    ' + script.start; }).join(',\n') + '\n};\n';
+
+var headerData = '// Generated by tools/sprite_script from ' + inFile + '. The id of each script, for sprite_definitions.c.\n\n' +
+    scripts.map(function(script, id) { return '#define SPRITE_SCRIPT_' + script.name + ' ' + id; }).join('\n') + '\n\n' +
+    '// How many scripts there are.\n#define SPRITE_SCRIPT_COUNT ' + scripts.length + '\n';
+
+fs.writeFileSync(outBase + '.c', cData);
+fs.writeFileSync(outBase + '.h', headerData);
+
+out('Wrote ' + scripts.length + ' script(s), ' + position + ' of ' + MAX_SCRIPT_BYTES + ' bytes, to ' + outBase + '.c');
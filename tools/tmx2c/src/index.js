@@ -9,8 +9,8 @@
  */
 var VERSION = require('./package.json').version;
 
-// Expects exactly tmx2c infile outfile (first param is always node)
-if (process.argv.length != 6) {
+// Expects tmx2c auto name infile outfile, and optionally the max sprites per room (first param is always node)
+if (process.argv.length != 6 && process.argv.length != 7) {
     printUsage();
     process.exit(1);
 }
@@ -25,6 +25,25 @@ var tmxParse = require('tmx-parser'),
     SCREEN_WIDTH = 16,
     SCREEN_HEIGHT = 12,
     SCREEN_HEIGHT_PADDED = 16,
+    // Tiles are stored with the palette in the top 2 bits, so there are 64 different tiles as far as collisions go.
+    COLLISION_TILE_COUNT = 64,
+    // Bool properties you can set on tiles in Tiled, and the bit each one sets in the collision table. These need to
+    // match the TILE_COLLISION_ defines in source/sprites/collision.h.
+    COLLISION_PROPERTIES = {
+        solid: 0x01,
+        hazard: 0x02,
+        water: 0x04,
+        slow: 0x08,
+        one_way: 0x10
+    },
+    // Rooms are numbered with one byte in the game, (playerOverworldPosition) so a map can't have more than this.
+    MAX_ROOMS = 256,
+    // The most bytes of map data to put in one part. Each part is a banked unit of its own, so bank_packer can put
+    // them in different banks. A bank is 16k, so half of one leaves room for the packer to fit parts in around code.
+    MAX_PART_BYTES = 8192,
+    // The most sprites a room can have. This has to match MAP_MAX_SPRITES in source/map/map.h; the makefile passes
+    // that in for you.
+    maxRoomSprites = process.argv.length > 6 ? parseInt(process.argv[6], 10) : 8,
     outFile = process.argv[5] + '.c',
     outHeader = process.argv[5] + '.h',
     name = null,
@@ -36,7 +55,8 @@ function printDate() {
 
 function printUsage() {
     out('tmx2c version ' + VERSION);
-    out('Usage: tmx2c [bank number] [variable name] [file to convert] [file to save output to]');
+    out('Usage: tmx2c auto [variable name] [file to convert] [file to save output to] [max sprites per room (optional, default 8)]');
+    out('The first argument used to be the bank number. Banks are now picked by bank_packer, so pass `auto`.');
 }
 
 function out() {
@@ -55,6 +75,54 @@ function verbose() {
     }
 }
 
+if (isNaN(maxRoomSprites) || maxRoomSprites < 1 || maxRoomSprites > 127) {
+    out('The max sprites per room needs to be a number from 1 to 127; got "' + process.argv[6] + '"');
+    process.exit(1);
+}
+
+// The map gets its own banked unit named after it; tools/bank_packer decides which bank that ends up in.
+if (process.argv[2] != 'auto') {
+    out('WARNING: Ignoring bank number ' + process.argv[2] + ' - banks are now picked automatically. To force part of this ' +
+        'map into a bank, pin PRG_BANK_MAP_' + process.argv[3].toUpperCase() + '_PART_0 (or _1, _2...) in tools/cc65_config/bank_affinity.json.');
+}
+
+// Builds the collision table from the bool properties on tiles in the "Overworld Tiles" tileset. The same tile can
+// show up once for each palette; properties set on any of those copies count for all of them.
+function build_collision_table(tmxData) {
+    var table = [],
+        tileSet = null;
+    for (var i = 0; i < COLLISION_TILE_COUNT; i++) {
+        table.push(0);
+    }
+
+    (tmxData.tileSets || []).forEach(function(set) {
+        if (set.name == 'Overworld Tiles') {
+            tileSet = set;
+        }
+    });
+    if (!tileSet) {
+        out('WARNING: Could not find the "Overworld Tiles" tileset, so no tiles will be solid.');
+        return table;
+    }
+
+    (tileSet.tiles || []).forEach(function(tile) {
+        if (!tile || !tile.properties) {
+            return;
+        }
+        Object.keys(tile.properties).forEach(function(propertyName) {
+            var value = tile.properties[propertyName];
+            if (COLLISION_PROPERTIES[propertyName] === undefined) {
+                verbose('Ignoring unknown tile property "' + propertyName + '" on tile ' + tile.id);
+                return;
+            }
+            if (value === true || value === 'true') {
+                table[tile.id % COLLISION_TILE_COUNT] |= COLLISION_PROPERTIES[propertyName];
+            }
+        });
+    });
+    return table;
+}
+
 tmxParse.parseFile(process.argv[4], function(err, tmxData) {
     if (err || !tmxData) {
         out('Failed parsing TMX file - is it corrupt?', err, tmxData);
@@ -76,13 +144,25 @@ tmxParse.parseFile(process.argv[4], function(err, tmxData) {
         rawColumns = [],
         columnDefinitions = [],
         mapColumns = [],
-        fileData = '',
-        mapData = '',
-        spriteData = '',
+        // Every room, in room id order. (y * roomsWide + x) Each one has its C source, how many bytes that is, and how
+        // many sprites it has.
+        rooms = [],
+        // The most sprites any one room has.
+        mostRoomSprites = 0,
         containsWarnings = false;
 
     verbose('Map width: ' + width + ' height: ' + height + ' length: ' + (width * height) + ' bytes.');
-        
+
+    if (width % SCREEN_WIDTH || height % SCREEN_HEIGHT) {
+        out('The map has to be a whole number of rooms; each room is ' + SCREEN_WIDTH + ' by ' + SCREEN_HEIGHT + ' tiles. ' +
+            'This one is ' + width + ' by ' + height + '.');
+        process.exit(1);
+    }
+    if (roomsWide * roomsTall > MAX_ROOMS) {
+        out('The map is ' + roomsWide + ' by ' + roomsTall + ' rooms, but the game can only number ' + MAX_ROOMS + ' rooms. ' +
+            'Try splitting it up into two worlds.');
+        process.exit(1);
+    }
 
     for (var i = 0; i < tmxData.layers.length; i++) {
         if (tmxData.layers[i].name == 'Overworld Tiles') {
@@ -99,25 +179,23 @@ tmxParse.parseFile(process.argv[4], function(err, tmxData) {
 
     originalSize = data.length;
 
+    var collisionTable = build_collision_table(tmxData);
+
     // Loop through all rooms
     for (var y = 0; y < roomsTall; y++) {
         for (var x = 0; x < roomsWide; x++) {
-            var roomSpriteData = [];
-            if (x == 7 && y == 7) {
-                verbose('Skipping the final room, because there is not enough rom space the way we map things out. Perhaps if we used RLE...');
-                continue; // Skips this single iteration, but continues the loop.
-            }
-            mapData += "\n\n//Room (" + x + ":" + y + ")\n\n// Room data\n"
+            var roomSpriteData = [],
+                roomData = "\n\n//Room (" + x + ":" + y + ")\n\n// Room data\n";
 
             // loop through every tile in the room.
             for (var yy = 0; yy < SCREEN_HEIGHT; yy++) {
                 for (var xx = 0; xx < SCREEN_WIDTH; xx++) {
                     if (xx != 0) {
-                        mapData += ', '
+                        roomData += ', '
                     } else if (yy != 0) {
-                        mapData += ",\n";
+                        roomData += ",\n";
                     } else {
-                        mapData += "\n";
+                        roomData += "\n";
                     }
 
                     var pos = (x * SCREEN_WIDTH) + (y * (roomsWide*SCREEN_WIDTH)*SCREEN_HEIGHT) + (yy * width) + xx;
@@ -126,7 +204,7 @@ tmxParse.parseFile(process.argv[4], function(err, tmxData) {
                         out('WARNING: Sprite (id: ' + data[pos].gid + ') found on map layer in room ( ' + x + ', ' + y + ') - this sprite will be skipped! Please move it to the sprite layer.');
                         data[pos].gid = 0;
                     }
-                    mapData += data[pos].gid - 1;
+                    roomData += data[pos].gid - 1;
 
                     if (spriteData[pos]) {
                         if (spriteData[pos].gid < 256) {
@@ -140,49 +218,144 @@ tmxParse.parseFile(process.argv[4], function(err, tmxData) {
     
                 }
             }
-            mapData += ","
-            // Pad roomSpriteData to 8 sprites, and add a bit of padding to max out to 32 bytes.
-            if (roomSpriteData.length > 16) {
+            roomData += ","
+            if (roomSpriteData.length > maxRoomSprites * 2) {
                 containsWarnings = true;
-                out('WARNING: Truncating room (' + x + ',' + y + ') to max 12 sprites. The engine cannot support more; please clean some up.');
-                roomSpriteData.length = 32;
+                out('WARNING: Truncating room (' + x + ',' + y + ') to max ' + maxRoomSprites + ' sprites. The engine cannot support more; please clean some up.');
+                roomSpriteData.length = maxRoomSprites * 2;
             }
-            while (roomSpriteData.length < 32) {
-                roomSpriteData.push(255);
+            mostRoomSprites = Math.max(mostRoomSprites, roomSpriteData.length / 2);
+
+            // Okay, main room data is done, add sprites. First how many there are, then 2 bytes for each one. A room
+            // with no sprites only costs the 1 byte.
+            roomData += "\n\n// Sprite Data (count first)\n" + (roomSpriteData.length / 2);
+            for (var i = 0; i < roomSpriteData.length; i += 2) {
+                roomData += ((i % 16) == 0 ? ",\n" : ", ") + roomSpriteData[i] + ', ' + roomSpriteData[i+1];
             }
-            
-            // Okay, main room data is done, add sprites
-            mapData += "\n\n// Sprite Data\n";
-            for (var i = 0; i < 15; i++)
-                mapData += roomSpriteData[i] + ', ';
-            mapData += roomSpriteData[15] + ",\n";
-            for (var i = 16; i < 31; i++)
-                mapData += roomSpriteData[i] + ', ';
-            mapData += roomSpriteData[31]+ ",\n";
-
-            // Lastly, we want things to line up perfectly so we have 256 per map tile (makes math easier)
-            // So, add some padding. (Note: If you wanna add your own data, this is the spot!)
-            mapData += '// add a little padding - we want each map screen to take up exactly 256 bytes to make math easier.\n';
-            mapData += '0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \n';
-            mapData += '0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, \n\n';
+            roomData += ",";
 
+            rooms.push({
+                data: roomData,
+                byteCount: SCREEN_WIDTH * SCREEN_HEIGHT + 1 + roomSpriteData.length,
+                spriteCount: roomSpriteData.length / 2
+            });
         }
     }
 
-    // Kill the very last comma
-    mapData = mapData.replace(/,\s*$/, '');
-    // Add a note about 7,7 to the acutal output, to make it clear.
-    mapData += "\n\n// Room (7:7) skipped due to space constraints\n\n";
-    // Need to include the count of characters to make C happy :(
-    var elementCount = mapData.split(',').length;
+    // Split the rooms up into parts, in order, starting a new part whenever the next room won't fit in this one. Each
+    // room remembers which part it went into, and where it starts in there. Rooms aren't all the same length, (fewer
+    // sprites means fewer bytes) so the game can't just multiply to find them.
+    var parts = [];
+    rooms.forEach(function(room) {
+        var part = parts[parts.length - 1];
+        if (!part || part.byteCount + room.byteCount > MAX_PART_BYTES) {
+            part = {data: '', byteCount: 0};
+            parts.push(part);
+        }
+        room.part = parts.length - 1;
+        room.start = part.byteCount;
+        part.data += room.data;
+        part.byteCount += room.byteCount;
+    });
+    verbose('Split ' + rooms.length + ' rooms into ' + parts.length + ' part(s).');
 
+    var mapName = process.argv[3],
+        upperName = mapName.toUpperCase();
 
+    // Writes out a C array of numbers, 8 to a line, so the tables below stay readable.
+    function numberTable(type, tableName, numbers) {
+        return 'const ' + type + ' ' + tableName + '[' + numbers.length + '] = {\n' +
+            numbers.map(function(number, id) {
+                return ((id % 8) ? ' ' : '    ') + number + (id < numbers.length - 1 ? ',' : '') + ((id % 8) == 7 ? '\n' : '');
+            }).join('') + (numbers.length % 8 ? '\n' : '') + '};\n\n';
+    }
+
+    // The collision table goes in before CODE_BANK, so it lands in the fixed bank where the sprite code can always see it.
+    var collisionData = "// Collision properties for every tile, from the tile properties in Tiled. See TILE_COLLISION_ in collision.h.\n" +
+        'const unsigned char ' + mapName + 'TileCollision[' + COLLISION_TILE_COUNT + '] = {\n' +
+        collisionTable.map(function(flags, id) {
+            return ((id % 16) ? ' ' : '    ') + '0x' + (flags < 16 ? '0' : '') + flags.toString(16) + (id < COLLISION_TILE_COUNT - 1 ? ',' : '') + ((id % 16) == 15 ? '\n' : '');
+        }).join('') + '};\n\n';
+
+    // Every sprite on the map gets one bit in spritePersistence, (see map.h) so the game can remember which ones have
+    // been collected. Rooms only get bits for the sprites they actually have, so this lists where each room's bits
+    // start, counting from the first bit of this world.
+    var persistBits = 0,
+        persistStarts = rooms.map(function(room) {
+            var start = persistBits;
+            persistBits += room.spriteCount;
+            return start;
+        });
+    verbose('Sprites use ' + persistBits + ' bits of persistence.');
+
+    // The index says where to find each room: which part it's in, and where it starts in there. It's a unit of its
+    // own, so load_map can look a room up, then switch over to whichever bank that room's part landed in.
+    var indexData = "// Which part of the map each room is in, by room id.\n" +
+        numberTable('unsigned char', mapName + 'RoomPart', rooms.map(function(room) { return room.part; })) +
+        "// Where each room starts in its part, by room id.\n" +
+        numberTable('unsigned int', mapName + 'RoomStart', rooms.map(function(room) { return room.start; })) +
+        "// Where each room's bits start in spritePersistence, counting from the start of this world. (See map.h)\n" +
+        numberTable('unsigned int', mapName + 'SpritePersistStart', persistStarts) +
+        "// Where each part starts. (Use " + upperName + "_PART_BANK to find its bank)\n" +
+        'const unsigned char* const ' + mapName + 'Parts[' + parts.length + '] = {\n' +
+        parts.map(function(part, id) { return '    ' + mapName + 'Part' + id; }).join(',\n') + '\n};\n\n';
+
+    var partData = parts.map(function(part, id) {
+        // Kill the very last comma, then use a little trick to tab every single line in, so our output looks nicer
+        var data = part.data.replace(/,\s*$/, '');
+        data = "    " + data.replace(/[\n]/g, "\n    ");
+        return "CODE_BANK(PRG_BANK_MAP_" + upperName + "_PART_" + id + ");\n\n" +
+            'const unsigned char ' + mapName + 'Part' + id + '[' + part.byteCount + '] = {\n' + data + "\n\n\n};\n\nCODE_BANK_POP();\n\n";
+    }).join('');
+
+    // Bank numbers are only known at link time, so they can't go into a table like the rest. (See temp/prg_banks.h)
+    // Instead, the header gets a macro that picks the right one.
+    var partBank = 'PRG_BANK_MAP_' + upperName + '_PART_' + (parts.length - 1);
+    for (var i = parts.length - 2; i >= 0; i--) {
+        partBank = '(part) == ' + i + ' ? PRG_BANK_MAP_' + upperName + '_PART_' + i + ' : ' + partBank;
+    }
 
-    // Little trick to tab every single line in, so our output looks nicer
-    mapData = "    " + mapData.replace(/[\n]/g, "\n    ");
+    // load_map calls this to find a room in this map. It lives in the fixed bank with the collision table, so it can
+    // switch to the index's bank and back. (See worldFindRoom in source/map/load_map.c)
+    var findRoomData = "// Looks up the room at playerOverworldPosition in this map, and sets currentRoomBank and currentRoomData to where\n" +
+        "// its data is. currentRoomSpritePersistStart is set to where its bits start, counting from the start of this world.\n" +
+        'void ' + mapName + '_find_room() {\n' +
+        '    bank_push(PRG_BANK_MAP_' + upperName + ');\n' +
+        '    currentRoomPart = ' + mapName + 'RoomPart[playerOverworldPosition];\n' +
+        '    currentRoomData = ' + mapName + 'Parts[currentRoomPart] + ' + mapName + 'RoomStart[playerOverworldPosition];\n' +
+        '    currentRoomSpritePersistStart = ' + mapName + 'SpritePersistStart[playerOverworldPosition];\n' +
+        '    bank_pop();\n' +
+        '    currentRoomBank = ' + upperName + '_PART_BANK(currentRoomPart);\n' +
+        '}\n\n';
 
-    mapData = "#include \"source/library/bank_helpers.h\"\n#include \""+process.argv[5]+".h\"\n\nCODE_BANK(PRG_BANK_MAP_"+process.argv[3].toUpperCase()+");\n\n"+'const unsigned char ' + process.argv[3] + "["+elementCount+"] = {\n\n" + mapData + "\n\n\n};\n";
-    var headerData = "// This is the data for your entire map, as made available in the .c file of this name\n\n#define PRG_BANK_MAP_"+process.argv[3].toUpperCase()+" "+process.argv[2]+"\nextern const unsigned char "+process.argv[3]+"[" + elementCount + "];";
+    var mapData = "#include \"source/library/bank_helpers.h\"\n#include \"source/map/map.h\"\n#include \""+process.argv[5]+".h\"\n\n" + collisionData + findRoomData +
+        "CODE_BANK(PRG_BANK_MAP_" + upperName + ");\n\n" + indexData + "CODE_BANK_POP();\n\n" + partData;
+    var headerData = "// This is the data for your entire map, as made available in the .c file of this name\n" +
+        "// The map is " + roomsWide + " rooms wide and " + roomsTall + " rooms tall. A room's id is x + (y * " + upperName + "_WIDTH).\n" +
+        "#define " + upperName + "_WIDTH " + roomsWide + "\n" +
+        "#define " + upperName + "_HEIGHT " + roomsTall + "\n" +
+        "#define " + upperName + "_ROOM_COUNT " + rooms.length + "\n\n" +
+        "// Collision properties for each of the 64 tiles, (TILE_COLLISION_ bits) in the fixed bank.\nextern const unsigned char "+mapName+"TileCollision[" + COLLISION_TILE_COUNT + "];\n\n" +
+        "// Finds the room at playerOverworldPosition in this map, for load_map. In the fixed bank.\nvoid " + mapName + "_find_room();\n\n" +
+        "// The rooms are split up into parts, so they can be spread over several banks. Part 0 is in the\n" +
+        "// PRG_BANK_MAP_" + upperName + "_PART_0 bank, part 1 in PRG_BANK_MAP_" + upperName + "_PART_1, and so on.\n" +
+        parts.map(function(part, id) { return 'extern const unsigned char ' + mapName + 'Part' + id + '[' + part.byteCount + '];\n'; }).join('') +
+        "#define " + upperName + "_PART_COUNT " + parts.length + "\n" +
+        "// The bank a part is in.\n" +
+        "#define " + upperName + "_PART_BANK(part) (" + partBank + ")\n\n" +
+        "// Everything below is in the PRG_BANK_MAP_" + upperName + " bank.\n" +
+        "// Which part each room is in, and where it starts in that part, by room id. (Each room is the tiles, the number\n" +
+        "// of sprites, then 2 bytes for each sprite, so they aren't all the same length.)\n" +
+        "extern const unsigned char "+mapName+"RoomPart[" + rooms.length + "];\n" +
+        "extern const unsigned int "+mapName+"RoomStart[" + rooms.length + "];\n" +
+        "// Where each part starts.\n" +
+        "extern const unsigned char* const "+mapName+"Parts[" + parts.length + "];\n" +
+        "// The most sprites any room on this map has. (map.h checks that this fits in MAP_MAX_SPRITES)\n" +
+        "#define " + upperName + "_MOST_ROOM_SPRITES " + mostRoomSprites + "\n\n" +
+        "// Where each room's sprites start in spritePersistence, (in bits, from the start of this world) and how many bits\n" +
+        "// the whole world needs. Each room gets one bit per sprite it has.\n" +
+        "extern const unsigned int "+mapName+"SpritePersistStart[" + rooms.length + "];\n" +
+        "#define " + upperName + "_SPRITE_PERSIST_BITS " + persistBits + "\n";
 
     fs.writeFileSync(process.argv[5]+'.c', mapData);
     fs.writeFileSync(process.argv[5]+'.h', headerData);